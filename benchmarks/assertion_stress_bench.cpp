@@ -0,0 +1,57 @@
+/**
+ * Assertion recording throughput as the number of asserting threads grows
+ *
+ * Every thread asserts into the same test, so all shards feed one TestResults.
+ * Usage: tUnitStressBench [assertions_per_thread] [max_threads]
+ */
+#include "tUnit.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+  const size_t per_thread = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+  const size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+
+  auto &orchestrator = tUnit::Orchestrator::instance();
+  orchestrator.set_retention(tUnit::Retention::failures);
+  auto &suite = orchestrator.get_suite("Stress");
+
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "assertions" << std::setw(12) << "seconds"
+            << std::setw(16) << "Massert/s" << std::setw(12) << "ns/assert" << "\n";
+
+  for (size_t threads = 1; threads <= max_threads; threads *= 2)
+  {
+    auto &test = suite.get_test("threads=" + std::to_string(threads));
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t t = 0; t < threads; ++t)
+    {
+      workers.emplace_back([&test, per_thread]()
+                           {
+        for (size_t i = 0; i < per_thread; ++i)
+        {
+          test.expect("stress assertion", i < per_thread);
+        } });
+    }
+    for (auto &worker : workers)
+    {
+      worker.join();
+    }
+    orchestrator.collect();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t total = test.results().total_;
+    std::cout << std::setw(8) << threads << std::setw(16) << total << std::setw(12) << std::fixed << std::setprecision(3) << seconds
+              << std::setw(16) << std::setprecision(1) << total / seconds / 1e6
+              << std::setw(12) << std::setprecision(2) << seconds * 1e9 * threads / total << "\n";
+  }
+
+  return orchestrator.all_tests_passed() ? 0 : 1;
+}
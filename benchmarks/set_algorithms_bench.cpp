@@ -0,0 +1,109 @@
+/**
+ * is_unique, contains_all_elements and is_permutation_of strategies against each other, on int
+ * and std::string elements, to place detail::small_work
+ *
+ * Inputs are worst cases for the nested loops: unique values, every needle present, and a
+ * permutation (so every check runs to the end). Usage: tUnitSetBench [max_elements] (default 1M);
+ * the nested loops stop at 64k elements.
+ */
+#include "tUnit.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+namespace detail = tUnit::predicates::detail;
+
+const tUnit::BenchmarkOptions options{std::chrono::milliseconds(1), std::chrono::milliseconds(5), 5};
+constexpr std::size_t max_nested = 65536;
+
+template <typename F>
+double median_ns(const std::string &name, F body)
+{
+  return tUnit::detail::measure(name, body, options).median_ns_;
+}
+
+void report(const char *type, const char *check, const char *strategy, std::size_t n, double ns)
+{
+  std::cout << std::setw(7) << type << std::setw(13) << check << std::setw(14) << strategy << std::setw(10) << n << std::fixed
+            << std::setprecision(1) << std::setw(14) << ns << std::setw(12) << ns / static_cast<double>(n) << "\n";
+}
+
+template <typename T>
+T make(std::size_t i)
+{
+  if constexpr (std::is_same_v<T, std::string>)
+  {
+    return "element-" + std::to_string(i * 2654435761u % 1000000007u); // past the small-string buffer
+  }
+  else
+  {
+    return static_cast<T>(i * 2654435761u % 1000000007u);
+  }
+}
+
+template <typename T>
+void compare(const char *type, std::size_t n)
+{
+  std::mt19937 rng(7);
+  std::vector<T> values;
+  values.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    values.push_back(make<T>(i));
+  }
+  std::vector<T> shuffled = values;
+  std::shuffle(shuffled.begin(), shuffled.end(), rng);
+  std::vector<T> sorted = values;
+  std::sort(sorted.begin(), sorted.end());
+  bool sink = false;
+  auto run = [&](const char *check, const char *strategy, auto body)
+  { report(type, check, strategy, n, median_ns(strategy, [&] { sink = body(); tUnit::do_not_optimize(sink); })); };
+
+  if (n <= max_nested)
+  {
+    run("is_unique", "nested", [&] { return detail::unique_nested(values); });
+  }
+  run("is_unique", "hashed", [&] { return detail::unique_hashed(values); });
+  run("is_unique", "sorted", [&] { return detail::unique_sorted(values); });
+  run("is_unique", "sorted input", [&] { return detail::unique_sorted_input(sorted); });
+
+  if (n <= max_nested)
+  {
+    run("contains_all", "nested", [&] { return detail::contains_nested(values, shuffled, true); });
+  }
+  run("contains_all", "hashed", [&] { return detail::contains_hashed(values, shuffled, true); });
+  run("contains_all", "sorted", [&] { return detail::contains_sorted(values, shuffled, true); });
+  run("contains_all", "sorted input", [&] { return detail::contains_sorted_input(sorted, shuffled, true); });
+
+  if (n <= max_nested)
+  {
+    run("permutation", "nested", [&] { return detail::permutation_nested(values, shuffled); });
+  }
+  run("permutation", "hashed", [&] { return detail::permutation_hashed(values, shuffled); });
+  run("permutation", "sorted", [&] { return detail::permutation_sorted(values, shuffled); });
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  const std::size_t max_elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+  std::cout << "small_work: " << detail::small_work << " comparisons\n"
+            << std::setw(7) << "type" << std::setw(13) << "check" << std::setw(14) << "strategy" << std::setw(10) << "elements"
+            << std::setw(14) << "ns/call" << std::setw(12) << "ns/el" << "\n";
+
+  for (std::size_t n = 8; n <= max_elements; n *= 2)
+  {
+    compare<int>("int", n);
+    compare<std::string>("string", n);
+  }
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * Container predicate kernels against the generic std algorithms, on contiguous int32 and float data
+ *
+ * Every check scans the whole range (the value searched for is absent, the data is sorted and
+ * equal), so time grows with the size. Usage: tUnitSimdBench [max_elements] (default 100M)
+ */
+#include "tUnit.h"
+#include "utils/simd_kernels.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+namespace simd = tUnit::utils::simd;
+
+const tUnit::BenchmarkOptions options{std::chrono::milliseconds(1), std::chrono::milliseconds(5), 5};
+
+template <typename F>
+double median_ns(const std::string &name, F body)
+{
+  return tUnit::detail::measure(name, body, options).median_ns_;
+}
+
+void report(const char *type, const char *check, std::size_t n, double generic_ns, double kernel_ns)
+{
+  std::cout << std::setw(7) << type << std::setw(12) << check << std::setw(12) << n << std::fixed << std::setprecision(3)
+            << std::setw(14) << generic_ns / static_cast<double>(n) << std::setw(14) << kernel_ns / static_cast<double>(n)
+            << std::setw(10) << std::setprecision(2) << generic_ns / kernel_ns << "x\n";
+}
+
+template <typename T>
+void compare(const char *type, std::size_t n)
+{
+  std::vector<T> values(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    values[i] = static_cast<T>(i % 1000000 + 1) + static_cast<T>(i / 1000000) * 1000000;
+  }
+  const std::vector<T> copy = values;
+  const T absent = T(0);
+  bool sink = false;
+
+  report(type, "find", n,
+         median_ns("generic", [&] { tUnit::do_not_optimize(std::find(values.begin(), values.end(), absent)); }),
+         median_ns("kernel", [&] { tUnit::do_not_optimize(simd::find(values.data(), n, absent)); }));
+  report(type, "is_sorted", n,
+         median_ns("generic", [&] { sink = std::is_sorted(values.begin(), values.end()); tUnit::do_not_optimize(sink); }),
+         median_ns("kernel", [&] { sink = simd::is_sorted(values.data(), n, false); tUnit::do_not_optimize(sink); }));
+  report(type, "equal", n,
+         median_ns("generic", [&] { sink = std::equal(values.begin(), values.end(), copy.begin(), copy.end()); tUnit::do_not_optimize(sink); }),
+         median_ns("kernel", [&] { sink = simd::equal(values.data(), copy.data(), n); tUnit::do_not_optimize(sink); }));
+  report(type, "count_pos", n,
+         median_ns("generic", [&] { tUnit::do_not_optimize(std::count_if(values.begin(), values.end(), tUnit::predicates::is_positive{})); }),
+         median_ns("kernel", [&] { tUnit::do_not_optimize(simd::count(values.data(), n, simd::ElementTest::positive)); }));
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  const std::size_t max_elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+
+  std::cout << "kernels: " << simd::level_name(simd::best_level()) << "\n"
+            << std::setw(7) << "type" << std::setw(12) << "check" << std::setw(12) << "elements" << std::setw(14) << "generic ns/el"
+            << std::setw(14) << "kernel ns/el" << std::setw(11) << "speedup" << "\n";
+
+  std::size_t n = 16;
+  for (; n < max_elements; n *= 8)
+  {
+    compare<std::int32_t>("int32", n);
+    compare<float>("float", n);
+  }
+  compare<std::int32_t>("int32", max_elements);
+  compare<float>("float", max_elements);
+  return 0;
+}
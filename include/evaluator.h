@@ -10,22 +10,48 @@ namespace tUnit
 
 /**
  * Core evaluation engine that applies predicates to compare values
+ *
+ * Each of T, U and P is either a reference or a value type: with the deduction guides below,
+ * lvalue operands and predicates are held by reference, so a large container or a stateful
+ * predicate is never copied, and rvalues are moved in and owned. An Evaluator built from
+ * lvalues must not outlive them.
  */
-template <typename T, typename U = T, typename P = bool (*)(const T &, const U &)>
+template <typename T, typename U = T, typename P = bool (*)(const std::remove_reference_t<T> &, const std::remove_reference_t<U> &)>
 class Evaluator
 {
 private:
+  using lhs_type = std::remove_reference_t<T>;
+  using rhs_type = std::remove_reference_t<U>;
+
   T lhs_;
   U rhs_;
   P pred_;
 
 public:
-  constexpr Evaluator(const T &lhs, const U &rhs, P pred) noexcept : lhs_(lhs), rhs_(rhs), pred_(pred) {}
+  template <typename L, typename R, typename Q>
+  constexpr Evaluator(L &&lhs, R &&rhs, Q &&pred) noexcept(std::is_nothrow_constructible_v<T, L &&> && std::is_nothrow_constructible_v<U, R &&> &&
+                                                           std::is_nothrow_constructible_v<P, Q &&>)
+      : lhs_(std::forward<L>(lhs)), rhs_(std::forward<R>(rhs)), pred_(std::forward<Q>(pred))
+  {
+  }
+
+  // Function templates and overload sets, e.g. Evaluator(1, 1, is_equal_func), resolve against P
+  template <typename L, typename R>
+  constexpr Evaluator(L &&lhs, R &&rhs, P pred) : lhs_(std::forward<L>(lhs)), rhs_(std::forward<R>(rhs)), pred_(std::forward<P>(pred))
+  {
+  }
 
-  bool use(const T &lhs, const U &rhs) const { return pred_(lhs, rhs); }
-  bool compare(const U &rhs) const { return pred_(lhs_, rhs); }
-  bool evaluate() const { return pred_(lhs_, rhs_); }
-  bool operator()() const { return this->evaluate(); }
+  // constexpr whenever the predicate is (TUNIT_MODE=1), see TUNIT_STATIC_ASSERT
+  constexpr bool use(const lhs_type &lhs, const rhs_type &rhs) const { return pred_(lhs, rhs); }
+  constexpr bool compare(const rhs_type &rhs) const { return pred_(lhs_, rhs); }
+  constexpr bool evaluate() const { return pred_(lhs_, rhs_); }
+  constexpr bool operator()() const { return this->evaluate(); }
 };
 
+// Lvalues deduce reference members (held), rvalues value members (moved in)
+template <typename L, typename R, typename Q>
+Evaluator(L &&, R &&, Q &&) -> Evaluator<L, R, Q>;
+template <typename L, typename R>
+Evaluator(L &&, R &&, bool (*)(const std::remove_reference_t<L> &, const std::remove_reference_t<R> &)) -> Evaluator<L, R>;
+
 } // namespace tUnit
@@ -10,13 +10,45 @@
 #include <type_traits>
 #include <utility>
 
+#include "predicates/collections/set_algorithms.h"
+#include "predicates/common/numeric_predicates.h"
 #include "predicates/predicate_config.h"
+#include "utils/simd_kernels.h"
 
 namespace tUnit
 {
 namespace predicates
 {
 
+namespace detail
+{
+
+// The built-in numeric predicates have vectorized kernels over contiguous arithmetic ranges
+template <typename C, typename P>
+constexpr bool has_element_test_v = utils::simd::has_kernels_v<C> &&
+                                    (std::is_same_v<std::decay_t<P>, is_positive> || std::is_same_v<std::decay_t<P>, is_negative> ||
+                                     std::is_same_v<std::decay_t<P>, is_zero> ||
+                                     ((std::is_same_v<std::decay_t<P>, is_even> || std::is_same_v<std::decay_t<P>, is_odd>) &&
+                                      std::is_integral_v<utils::simd::kernel_element_t<C>>));
+
+template <typename P>
+constexpr utils::simd::ElementTest element_test()
+{
+  using utils::simd::ElementTest;
+  using Pred = std::decay_t<P>;
+  if constexpr (std::is_same_v<Pred, is_positive>) return ElementTest::positive;
+  else if constexpr (std::is_same_v<Pred, is_negative>) return ElementTest::negative;
+  else if constexpr (std::is_same_v<Pred, is_zero>) return ElementTest::zero;
+  else if constexpr (std::is_same_v<Pred, is_even>) return ElementTest::even;
+  else return ElementTest::odd;
+}
+
+// Both ranges are contiguous with the same kernel element type
+template <typename C1, typename C2>
+constexpr bool has_pair_kernels_v = utils::simd::has_kernels_v<C1> && std::is_same_v<utils::simd::kernel_element_t<C1>, utils::simd::kernel_element_t<C2>>;
+
+} // namespace detail
+
 // ********************** Container Element Predicates **********************
 
 /**
@@ -30,6 +62,13 @@ struct contains_element
   TUNIT_CONSTEXPR bool operator()(const T &c1, const U &element) const
   {
     TUNIT_TRACE_PREDICATE("contains_element");
+    if constexpr (utils::simd::has_kernels_v<T> && std::is_same_v<std::decay_t<U>, utils::simd::kernel_element_t<T>>)
+    {
+      if (TUNIT_SIMD_RUNTIME())
+      {
+        return utils::simd::find(std::data(c1), std::size(c1), element) != std::size(c1);
+      }
+    }
     // Argument-Dependent Lookup (ADL)
     using std::begin, std::end;
     return std::find(begin(c1), end(c1), element) != end(c1);
@@ -63,9 +102,7 @@ struct contains_all_elements
   TUNIT_CONSTEXPR bool operator()(const T &c1, const U &c2) const
   {
     TUNIT_TRACE_PREDICATE("contains_all_elements");
-    using std::begin, std::end;
-    return std::all_of(begin(c2), end(c2), [&c1](const auto &element)
-                       { return std::find(begin(c1), end(c1), element) != end(c1); });
+    return detail::contains(c1, c2, true);
   }
 };
 
@@ -80,9 +117,7 @@ struct contains_any_elements
   TUNIT_CONSTEXPR bool operator()(const T &c1, const U &c2) const
   {
     TUNIT_TRACE_PREDICATE("contains_any_elements");
-    using std::begin, std::end;
-    return std::any_of(begin(c2), end(c2), [&c1](const auto &element)
-                       { return std::find(begin(c1), end(c1), element) != end(c1); });
+    return detail::contains(c1, c2, false);
   }
 };
 
@@ -192,6 +227,13 @@ struct all_elements_satisfy
   TUNIT_CONSTEXPR bool operator()(const T &c1, P &&pred) const
   {
     TUNIT_TRACE_PREDICATE("all_elements_satisfy");
+    if constexpr (detail::has_element_test_v<T, P>)
+    {
+      if (TUNIT_SIMD_RUNTIME())
+      {
+        return utils::simd::find_test(std::data(c1), std::size(c1), detail::element_test<P>(), false) == std::size(c1);
+      }
+    }
     using std::begin, std::end;
     return std::all_of(begin(c1), end(c1), std::forward<P>(pred));
   }
@@ -208,6 +250,13 @@ struct any_element_satisfies
   TUNIT_CONSTEXPR bool operator()(const T &c1, P &&pred) const
   {
     TUNIT_TRACE_PREDICATE("any_element_satisfies");
+    if constexpr (detail::has_element_test_v<T, P>)
+    {
+      if (TUNIT_SIMD_RUNTIME())
+      {
+        return utils::simd::find_test(std::data(c1), std::size(c1), detail::element_test<P>(), true) != std::size(c1);
+      }
+    }
     using std::begin, std::end;
     return std::any_of(begin(c1), end(c1), std::forward<P>(pred));
   }
@@ -224,6 +273,13 @@ struct no_elements_satisfy
   TUNIT_CONSTEXPR bool operator()(const T &c1, P &&pred) const
   {
     TUNIT_TRACE_PREDICATE("no_elements_satisfy");
+    if constexpr (detail::has_element_test_v<T, P>)
+    {
+      if (TUNIT_SIMD_RUNTIME())
+      {
+        return utils::simd::find_test(std::data(c1), std::size(c1), detail::element_test<P>(), true) == std::size(c1);
+      }
+    }
     using std::begin, std::end;
     return std::none_of(begin(c1), end(c1), std::forward<P>(pred));
   }
@@ -241,7 +297,15 @@ struct count_elements_satisfying
   {
     TUNIT_TRACE_PREDICATE("count_elements_satisfying");
     using std::begin, std::end;
-    return std::count_if(begin(c1), end(c1), std::forward<P>(pred));
+    using count_type = typename std::iterator_traits<decltype(begin(c1))>::difference_type;
+    if constexpr (detail::has_element_test_v<T, P>)
+    {
+      if (TUNIT_SIMD_RUNTIME())
+      {
+        return static_cast<count_type>(utils::simd::count(std::data(c1), std::size(c1), detail::element_test<P>()));
+      }
+    }
+    return static_cast<count_type>(std::count_if(begin(c1), end(c1), std::forward<P>(pred)));
   }
 };
 
@@ -306,6 +370,13 @@ struct is_sorted
   TUNIT_CONSTEXPR bool operator()(const T &c1) const
   {
     TUNIT_TRACE_PREDICATE("is_sorted");
+    if constexpr (utils::simd::has_kernels_v<T>)
+    {
+      if (TUNIT_SIMD_RUNTIME())
+      {
+        return utils::simd::is_sorted(std::data(c1), std::size(c1), false);
+      }
+    }
     using std::begin, std::end;
     return std::is_sorted(begin(c1), end(c1));
   }
@@ -330,13 +401,20 @@ struct is_reverse_sorted
   TUNIT_CONSTEXPR bool operator()(const T &c1) const
   {
     TUNIT_TRACE_PREDICATE("is_reverse_sorted");
+    if constexpr (utils::simd::has_kernels_v<T>)
+    {
+      if (TUNIT_SIMD_RUNTIME())
+      {
+        return utils::simd::is_sorted(std::data(c1), std::size(c1), true);
+      }
+    }
     using std::begin, std::end;
     return std::is_sorted(begin(c1), end(c1), std::greater<>{});
   }
 };
 
 /**
- * Tests if all elements in a container are unique
+ * Tests if all elements in a container are unique, without copying it (see set_algorithms.h)
  */
 struct is_unique
 {
@@ -346,10 +424,7 @@ struct is_unique
   TUNIT_CONSTEXPR bool operator()(const T &c1) const
   {
     TUNIT_TRACE_PREDICATE("is_unique");
-    using std::begin, std::end;
-    auto sorted_copy = c1;
-    std::sort(begin(sorted_copy), end(sorted_copy));
-    return std::adjacent_find(begin(sorted_copy), end(sorted_copy)) == end(sorted_copy);
+    return detail::is_unique(c1);
   }
 };
 
@@ -366,6 +441,13 @@ struct containers_equal
   TUNIT_CONSTEXPR bool operator()(const T &c1, const U &c2) const
   {
     TUNIT_TRACE_PREDICATE("containers_equal");
+    if constexpr (detail::has_pair_kernels_v<T, U>)
+    {
+      if (TUNIT_SIMD_RUNTIME())
+      {
+        return std::size(c1) == std::size(c2) && utils::simd::equal(std::data(c1), std::data(c2), std::size(c1));
+      }
+    }
     using std::begin, std::end;
     return std::equal(begin(c1), end(c1), begin(c2), end(c2));
   }
@@ -390,8 +472,7 @@ struct is_permutation_of
   TUNIT_CONSTEXPR bool operator()(const T &c1, const U &c2) const
   {
     TUNIT_TRACE_PREDICATE("is_permutation_of");
-    using std::begin, std::end;
-    return std::is_permutation(begin(c1), end(c1), begin(c2), end(c2));
+    return detail::is_permutation(c1, c2);
   }
 
   template <typename T, typename U, typename P>
@@ -0,0 +1,469 @@
+/**
+ * Membership strategies behind is_unique, contains_all_elements, contains_any_elements and
+ * is_permutation_of, chosen by element traits
+ *
+ * - an input that is already sorted is used as is (adjacent or binary search, nothing allocated);
+ *   not for floating point, where NaN breaks the ordering
+ * - hashable elements: an unordered index of pointers to the elements, O(n) expected
+ * - ordered elements: a sorted vector of pointers to the elements, O(n log n); also integer
+ *   elements up to small_sort, where sorting beats hashing
+ * - otherwise, and below small_work where building an index costs more than it saves: the
+ *   nested loops, O(n * m)
+ * < need not agree with ==: a user type may order by a key, e.g. one field. Order-based
+ * strategies find the run of elements equivalent under < and compare with == only within it,
+ * which costs nothing extra when every run is one element. Integers and strings, where
+ * equivalent means equal, skip that step.
+ * Indexes hold pointers, so elements (e.g. std::string) are never copied. The crossover points
+ * are measured by tUnitSetBench.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "utils/simd_kernels.h"
+
+namespace tUnit
+{
+namespace predicates
+{
+namespace detail
+{
+
+// Nested loops up to this many element comparisons (n * m, or n * n / 2 for uniqueness): past
+// it an index wins from about 32 string or 64 int elements per side (tUnitSetBench)
+constexpr std::size_t small_work = 1024;
+
+// Integers sort faster than they hash up to about this many elements
+constexpr std::size_t small_sort = 2048;
+
+template <typename C>
+using element_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::begin(std::declval<const C &>()))>>;
+
+// Iteration yields references to stored elements, so their addresses can be indexed
+template <typename C>
+constexpr bool has_stable_elements_v = std::is_reference_v<decltype(*std::begin(std::declval<const C &>()))>;
+
+template <typename T, typename = void>
+struct is_hashable : std::false_type
+{
+};
+
+template <typename T>
+struct is_hashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T &>())), decltype(std::declval<const T &>() == std::declval<const T &>())>>
+    : std::true_type
+{
+};
+
+template <typename T, typename = void>
+struct is_ordered : std::false_type
+{
+};
+
+template <typename T>
+struct is_ordered<T, std::void_t<decltype(std::declval<const T &>() < std::declval<const T &>())>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_string_like : std::false_type
+{
+};
+
+template <typename Char, typename Traits, typename Allocator>
+struct is_string_like<std::basic_string<Char, Traits, Allocator>> : std::true_type
+{
+};
+
+template <typename Char, typename Traits>
+struct is_string_like<std::basic_string_view<Char, Traits>> : std::true_type
+{
+};
+
+// Elements neither < the other are ==, so sorted ranges need no == within runs (not floating
+// point: NaN is equivalent to everything and equal to nothing)
+template <typename T>
+constexpr bool has_consistent_order_v = std::is_integral_v<T> || is_string_like<T>::value;
+
+// Sorted input is searched in place only under a strict weak order; NaN breaks it for floating point
+template <typename T>
+constexpr bool has_sorted_input_path_v = is_ordered<T>::value && !std::is_floating_point_v<T>;
+
+template <typename T>
+struct element_hash
+{
+  std::size_t operator()(const T *element) const { return std::hash<T>{}(*element); }
+};
+
+template <typename T>
+struct element_equal
+{
+  bool operator()(const T *lhs, const T *rhs) const { return *lhs == *rhs; }
+};
+
+template <typename T>
+struct element_less
+{
+  bool operator()(const T *lhs, const T *rhs) const { return *lhs < *rhs; }
+};
+
+template <typename C>
+std::size_t size_of(const C &c)
+{
+  using std::begin, std::end;
+  return static_cast<std::size_t>(std::distance(begin(c), end(c)));
+}
+
+// std::is_sorted, vectorized for contiguous arithmetic ranges
+template <typename C>
+bool is_sorted_range(const C &c)
+{
+  if constexpr (utils::simd::has_kernels_v<C>)
+  {
+    return utils::simd::is_sorted(std::data(c), std::size(c), false);
+  }
+  else
+  {
+    using std::begin, std::end;
+    return std::is_sorted(begin(c), end(c));
+  }
+}
+
+// The element an iterator of a pointer index refers to
+struct dereference
+{
+  template <typename T>
+  const T &operator()(const T *element) const { return *element; }
+};
+
+struct identity
+{
+  template <typename T>
+  const T &operator()(const T &element) const { return element; }
+};
+
+// End of the run of elements equivalent to *first under < in a sorted range
+template <typename It, typename Get>
+It run_end(It first, It last, Get get)
+{
+  It it = std::next(first);
+  while (it != last && !(get(*first) < get(*it)))
+  {
+    ++it;
+  }
+  return it;
+}
+
+// Whether no two elements of a sorted range are ==, comparing only within runs
+template <typename It, typename Get>
+bool unique_runs(It first, It last, Get get)
+{
+  while (first != last)
+  {
+    const It end = run_end(first, last, get);
+    for (It it = first; it != end; ++it)
+    {
+      for (It other = std::next(it); other != end; ++other)
+      {
+        if (get(*it) == get(*other)) return false;
+      }
+    }
+    first = end;
+  }
+  return true;
+}
+
+// Whether two sorted ranges of the same size hold the same elements, comparing only within runs
+template <typename It1, typename It2, typename Get>
+bool permutation_runs(It1 first1, It1 last1, It2 first2, It2 last2, Get get)
+{
+  auto equal = [&get](const auto &lhs, const auto &rhs)
+  { return get(lhs) == get(rhs); };
+  while (first1 != last1)
+  {
+    if (first2 == last2 || get(*first1) < get(*first2) || get(*first2) < get(*first1)) return false;
+    const It1 end1 = run_end(first1, last1, get);
+    const It2 end2 = run_end(first2, last2, get);
+    if (!std::is_permutation(first1, end1, first2, end2, equal)) return false;
+    first1 = end1;
+    first2 = end2;
+  }
+  return first2 == last2;
+}
+
+template <typename C>
+std::vector<const element_t<C> *> sorted_pointers(const C &c)
+{
+  std::vector<const element_t<C> *> pointers;
+  pointers.reserve(size_of(c));
+  for (const auto &element : c)
+  {
+    pointers.push_back(&element);
+  }
+  std::sort(pointers.begin(), pointers.end(), element_less<element_t<C>>{});
+  return pointers;
+}
+
+template <typename C>
+std::unordered_set<const element_t<C> *, element_hash<element_t<C>>, element_equal<element_t<C>>> hashed_pointers(const C &c)
+{
+  std::unordered_set<const element_t<C> *, element_hash<element_t<C>>, element_equal<element_t<C>>> pointers;
+  pointers.reserve(size_of(c));
+  for (const auto &element : c)
+  {
+    pointers.insert(&element);
+  }
+  return pointers;
+}
+
+// ********************** is_unique **********************
+
+template <typename C>
+bool unique_nested(const C &c)
+{
+  using std::begin, std::end;
+  for (auto it = begin(c); it != end(c); ++it)
+  {
+    if (std::find(std::next(it), end(c), *it) != end(c)) return false;
+  }
+  return true;
+}
+
+template <typename C>
+bool unique_sorted_input(const C &c)
+{
+  using std::begin, std::end;
+  if constexpr (has_consistent_order_v<element_t<C>>)
+  {
+    return std::adjacent_find(begin(c), end(c)) == end(c);
+  }
+  else
+  {
+    return unique_runs(begin(c), end(c), identity{});
+  }
+}
+
+template <typename C>
+bool unique_hashed(const C &c)
+{
+  std::unordered_set<const element_t<C> *, element_hash<element_t<C>>, element_equal<element_t<C>>> seen;
+  seen.reserve(size_of(c));
+  for (const auto &element : c)
+  {
+    if (!seen.insert(&element).second) return false;
+  }
+  return true;
+}
+
+template <typename C>
+bool unique_sorted(const C &c)
+{
+  const auto pointers = sorted_pointers(c);
+  if constexpr (has_consistent_order_v<element_t<C>>)
+  {
+    return std::adjacent_find(pointers.begin(), pointers.end(), element_equal<element_t<C>>{}) == pointers.end();
+  }
+  else
+  {
+    return unique_runs(pointers.begin(), pointers.end(), dereference{});
+  }
+}
+
+template <typename C>
+bool is_unique(const C &c)
+{
+  using E = element_t<C>;
+  const std::size_t n = size_of(c);
+  if constexpr (has_sorted_input_path_v<E>)
+  {
+    if (is_sorted_range(c)) return unique_sorted_input(c);
+  }
+  if constexpr (has_stable_elements_v<C>)
+  {
+    if (n * (n / 2) > small_work)
+    {
+      if constexpr (std::is_integral_v<E>)
+      {
+        if (n <= small_sort) return unique_sorted(c);
+      }
+      if constexpr (is_hashable<E>::value) return unique_hashed(c);
+      else if constexpr (is_ordered<E>::value) return unique_sorted(c);
+    }
+  }
+  return unique_nested(c);
+}
+
+// ********************** contains_all_elements / contains_any_elements **********************
+// all: every element of needles is in haystack; otherwise: at least one is
+
+template <typename C1, typename C2>
+bool contains_nested(const C1 &haystack, const C2 &needles, bool all)
+{
+  using std::begin, std::end;
+  auto found = [&haystack](const auto &element)
+  { return std::find(begin(haystack), end(haystack), element) != end(haystack); };
+  return all ? std::all_of(begin(needles), end(needles), found) : std::any_of(begin(needles), end(needles), found);
+}
+
+template <typename C1, typename C2>
+bool contains_sorted_input(const C1 &haystack, const C2 &needles, bool all)
+{
+  using std::begin, std::end;
+  auto found = [&haystack](const auto &element)
+  {
+    if constexpr (has_consistent_order_v<element_t<C1>>)
+    {
+      return std::binary_search(begin(haystack), end(haystack), element);
+    }
+    else
+    {
+      const auto run = std::equal_range(begin(haystack), end(haystack), element);
+      return std::find(run.first, run.second, element) != run.second;
+    }
+  };
+  return all ? std::all_of(begin(needles), end(needles), found) : std::any_of(begin(needles), end(needles), found);
+}
+
+template <typename C1, typename C2>
+bool contains_hashed(const C1 &haystack, const C2 &needles, bool all)
+{
+  using std::begin, std::end;
+  const auto index = hashed_pointers(haystack);
+  auto found = [&index](const auto &element)
+  { return index.count(&element) != 0; };
+  return all ? std::all_of(begin(needles), end(needles), found) : std::any_of(begin(needles), end(needles), found);
+}
+
+template <typename C1, typename C2>
+bool contains_sorted(const C1 &haystack, const C2 &needles, bool all)
+{
+  using std::begin, std::end;
+  const auto index = sorted_pointers(haystack);
+  auto found = [&index](const auto &element)
+  {
+    if constexpr (has_consistent_order_v<element_t<C1>>)
+    {
+      return std::binary_search(index.begin(), index.end(), &element, element_less<element_t<C1>>{});
+    }
+    else
+    {
+      const auto run = std::equal_range(index.begin(), index.end(), &element, element_less<element_t<C1>>{});
+      return std::any_of(run.first, run.second, [&element](const auto *candidate)
+                         { return *candidate == element; });
+    }
+  };
+  return all ? std::all_of(begin(needles), end(needles), found) : std::any_of(begin(needles), end(needles), found);
+}
+
+template <typename C1, typename C2>
+bool contains(const C1 &haystack, const C2 &needles, bool all)
+{
+  using E = element_t<C1>;
+  if constexpr (std::is_same_v<E, element_t<C2>> && has_stable_elements_v<C1> && has_stable_elements_v<C2>)
+  {
+    const std::size_t n = size_of(haystack);
+    const std::size_t m = size_of(needles);
+    if (n * m > small_work)
+    {
+      if constexpr (has_sorted_input_path_v<E>)
+      {
+        if (is_sorted_range(haystack)) return contains_sorted_input(haystack, needles, all);
+      }
+      if constexpr (is_hashable<E>::value) return contains_hashed(haystack, needles, all);
+      else if constexpr (is_ordered<E>::value) return contains_sorted(haystack, needles, all);
+    }
+  }
+  return contains_nested(haystack, needles, all);
+}
+
+// ********************** is_permutation_of **********************
+
+template <typename C1, typename C2>
+bool permutation_nested(const C1 &lhs, const C2 &rhs)
+{
+  using std::begin, std::end;
+  return std::is_permutation(begin(lhs), end(lhs), begin(rhs), end(rhs));
+}
+
+template <typename C1, typename C2>
+bool permutation_hashed(const C1 &lhs, const C2 &rhs)
+{
+  using E = element_t<C1>;
+  std::unordered_map<const E *, std::size_t, element_hash<E>, element_equal<E>> counts;
+  counts.reserve(size_of(lhs));
+  for (const auto &element : lhs)
+  {
+    ++counts[&element];
+  }
+  for (const auto &element : rhs)
+  {
+    auto it = counts.find(&element);
+    if (it == counts.end() || it->second == 0) return false;
+    --it->second;
+  }
+  return true; // equal sizes, so every count reached zero
+}
+
+template <typename C1, typename C2>
+bool permutation_sorted(const C1 &lhs, const C2 &rhs)
+{
+  const auto left = sorted_pointers(lhs);
+  const auto right = sorted_pointers(rhs);
+  if constexpr (has_consistent_order_v<element_t<C1>>)
+  {
+    return std::equal(left.begin(), left.end(), right.begin(), right.end(), element_equal<element_t<C1>>{});
+  }
+  else
+  {
+    return permutation_runs(left.begin(), left.end(), right.begin(), right.end(), dereference{});
+  }
+}
+
+template <typename C1, typename C2>
+bool is_permutation(const C1 &lhs, const C2 &rhs)
+{
+  using E = element_t<C1>;
+  const std::size_t n = size_of(lhs);
+  if (n != size_of(rhs)) return false;
+  if constexpr (std::is_same_v<E, element_t<C2>> && has_stable_elements_v<C1> && has_stable_elements_v<C2>)
+  {
+    if (n * n > small_work)
+    {
+      if constexpr (has_sorted_input_path_v<E>)
+      {
+        if (is_sorted_range(lhs) && is_sorted_range(rhs))
+        {
+          using std::begin, std::end;
+          if constexpr (has_consistent_order_v<E>)
+          {
+            return std::equal(begin(lhs), end(lhs), begin(rhs), end(rhs));
+          }
+          else
+          {
+            return permutation_runs(begin(lhs), end(lhs), begin(rhs), end(rhs), identity{});
+          }
+        }
+      }
+      if constexpr (std::is_integral_v<E>)
+      {
+        if (n <= small_sort) return permutation_sorted(lhs, rhs);
+      }
+      if constexpr (is_hashable<E>::value) return permutation_hashed(lhs, rhs);
+      else if constexpr (is_ordered<E>::value) return permutation_sorted(lhs, rhs);
+    }
+  }
+  return permutation_nested(lhs, rhs);
+}
+
+} // namespace detail
+} // namespace predicates
+} // namespace tUnit
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <cstdint>
 #include <string>
+#include <type_traits>
 
 #include "predicates/predicate_config.h"
 
@@ -25,9 +26,30 @@ struct is_perfect_square
   TUNIT_CONSTEXPR bool operator()(T value) const
   {
     TUNIT_TRACE_PREDICATE("is_perfect_square");
-    if (value < 0) return false;
-    std::int64_t root = static_cast<std::int64_t>(std::sqrt(value));
-    return root * root == value;
+    if constexpr (std::is_integral_v<T>)
+    {
+      if constexpr (std::is_signed_v<T>)
+      {
+        if (value < 0) return false;
+      }
+      // Integer Newton iteration instead of std::sqrt, so the check is constexpr. Unsigned, from
+      // n / 2 + 1 (never below the root): while root > n / root, root + n / root < 2 * root, so
+      // nothing overflows up to the largest unsigned long long
+      const unsigned long long n = static_cast<unsigned long long>(value);
+      if (n < 2) return true;
+      unsigned long long root = n / 2 + 1;
+      while (root > n / root)
+      {
+        root = (root + n / root) / 2;
+      }
+      return root * root == n;
+    }
+    else
+    {
+      if (value < 0) return false;
+      std::int64_t root = static_cast<std::int64_t>(std::sqrt(value));
+      return root * root == value;
+    }
   }
 };
 
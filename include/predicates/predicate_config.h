@@ -8,10 +8,10 @@
 // - (0): constexpr disabled, predicate tracing enabled - for development and debugging
 
 #ifndef TUNIT_MODE
-#define TUNIT_MODE 1 
+#define TUNIT_MODE 1
 #endif
 
-#if 0   // TUNIT_MODE
+#if TUNIT_MODE
 #define TUNIT_CONSTEXPR constexpr
 #define TUNIT_TRACE_PREDICATE(name) ((void)0)
 #else
@@ -4,6 +4,9 @@
  * Assertions:         tUnit/assertion.h
  * Test cases:         tUnit/test_case.h
  * Test orchestrator:  tUnit/test_orchestrator.h
+ * Run events:         tUnit/test_listener.h, tUnit/reporters.h
+ * Test registration:  tUnit/test_registry.h (TUNIT_TEST)
+ * Test selection:     tUnit/test_filter.h
  * Test suites:        tUnit/test_suite.h
  * Release asserts:    utils/release_asserts.h
  * Trace utilities:    utils/trace_support.h
@@ -15,7 +18,10 @@
 
 #include "tUnit/assertion.h"
 #include "tUnit/test_case.h"
+#include "tUnit/test_filter.h"
+#include "tUnit/reporters.h"
 #include "tUnit/test_orchestrator.h"
+#include "tUnit/test_registry.h"
 #include "tUnit/test_suite.h"
 
 // #include "utils/release_asserts.h"
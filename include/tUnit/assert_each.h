@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tUnit
+{
+
+/**
+ * Outcome of checking a predicate over a whole range, recorded as one assertion by Test::assert_each
+ */
+struct EachResult
+{
+  // At most this many failing elements are listed
+  static constexpr std::size_t listed_failures = 8;
+
+  std::size_t count_ = 0;  // elements (pairs) checked
+  std::size_t failed_ = 0; // of those, how many failed
+  std::size_t lhs_size_ = 0;
+  std::size_t rhs_size_ = 0;        // pairwise checks only: a length mismatch fails the check
+  std::vector<std::size_t> first_failures_; // indices, ascending
+  std::string failing_values_;      // "[i] = value" (or "[i] = lhs, rhs") for each listed index
+
+  bool passed() const { return failed_ == 0 && lhs_size_ == rhs_size_; }
+};
+
+namespace detail
+{
+
+template <typename T, typename = void>
+struct is_streamable : std::false_type
+{
+};
+
+template <typename T>
+struct is_streamable<T, std::void_t<decltype(std::declval<std::ostream &>() << std::declval<const T &>())>> : std::true_type
+{
+};
+
+template <typename T>
+void print_value(std::ostream &out, const T &value)
+{
+  if constexpr (is_streamable<T>::value)
+  {
+    out << value;
+  }
+  else
+  {
+    out << "?";
+  }
+}
+
+template <typename F>
+void list_failure(EachResult &result, std::size_t index, F &&print)
+{
+  std::ostringstream out;
+  out << (result.first_failures_.empty() ? "" : ", ") << '[' << index << "] = ";
+  print(out);
+  result.failing_values_ += out.str();
+  result.first_failures_.push_back(index);
+}
+
+// pred(element) over range, in one pass that calls pred once per element. The branch that
+// lists a failure is taken at most listed_failures times, so it predicts well.
+template <typename R, typename P>
+EachResult check_each(const R &range, P &&pred)
+{
+  EachResult result;
+  std::size_t count = 0;
+  std::size_t failed = 0;
+  for (const auto &element : range)
+  {
+    const bool ok = static_cast<bool>(pred(element));
+    failed += !ok;
+    if (!ok && result.first_failures_.size() < EachResult::listed_failures)
+    {
+      list_failure(result, count, [&](std::ostream &out) { print_value(out, element); });
+    }
+    ++count;
+  }
+  result.count_ = result.lhs_size_ = result.rhs_size_ = count;
+  result.failed_ = failed;
+  return result;
+}
+
+// pred(lhs[i], rhs[i]) over the common length of both ranges
+template <typename L, typename P, typename R>
+EachResult check_each(const L &lhs, P &&pred, const R &rhs)
+{
+  using std::begin, std::end;
+  EachResult result;
+  result.lhs_size_ = static_cast<std::size_t>(std::distance(begin(lhs), end(lhs)));
+  result.rhs_size_ = static_cast<std::size_t>(std::distance(begin(rhs), end(rhs)));
+  result.count_ = std::min(result.lhs_size_, result.rhs_size_);
+
+  std::size_t failed = 0;
+  auto l = begin(lhs);
+  auto r = begin(rhs);
+  for (std::size_t index = 0; index < result.count_; ++index, ++l, ++r)
+  {
+    const bool ok = static_cast<bool>(pred(*l, *r));
+    failed += !ok;
+    if (!ok && result.first_failures_.size() < EachResult::listed_failures)
+    {
+      list_failure(result, index,
+                   [&](std::ostream &out)
+                   {
+                     print_value(out, *l);
+                     out << ", ";
+                     print_value(out, *r);
+                   });
+    }
+  }
+  result.failed_ = failed;
+  return result;
+}
+
+// The assertion's description: the element count when it passed, else what failed and where
+std::string describe_each(std::string_view description, const EachResult &result);
+
+} // namespace detail
+} // namespace tUnit
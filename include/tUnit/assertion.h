@@ -1,19 +1,21 @@
 #pragma once
-#include <string>
+#include <string_view>
 
 namespace tUnit
 {
 
 /**
  * Represents a single test assertion with description and result
+ * The description is a view into the Orchestrator's interned description storage, which
+ * lives as long as the Orchestrator (the instance() singleton: until the process exits)
  */
 class Assertion
 {
 public:
-  std::string description_;
+  std::string_view description_;
   bool result_;
 
-  Assertion(const std::string &desc, bool result) : description_(desc), result_(result) {}
+  Assertion(std::string_view desc, bool result) : description_(desc), result_(result) {}
 };
 
-} // namespace tUnit
\ No newline at end of file
+} // namespace tUnit
@@ -0,0 +1,116 @@
+#pragma once
+#include "utils/perf_events.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tUnit
+{
+
+/**
+ * How a benchmark is measured; the defaults spend roughly 40 ms per benchmark
+ */
+struct BenchmarkOptions
+{
+  std::chrono::nanoseconds warmup_ = std::chrono::milliseconds(5);
+  std::chrono::nanoseconds min_sample_time_ = std::chrono::milliseconds(2); // iterations are calibrated to reach this
+  std::size_t samples_ = 15;
+};
+
+/**
+ * Per-iteration statistics over the samples of one benchmark
+ */
+struct BenchmarkResult
+{
+  std::string name_;
+  std::uint64_t iterations_ = 0; // per sample
+  std::vector<double> samples_ns_; // mean time per iteration of each sample
+  double min_ns_ = 0;
+  double median_ns_ = 0;
+  double mean_ns_ = 0;
+  double stddev_ns_ = 0;
+  utils::PerfCounts counters_; // --perf-counters: totals over every measured iteration
+
+  double ops_per_second() const { return mean_ns_ > 0 ? 1e9 / mean_ns_ : 0; }
+  double measured_iterations() const { return static_cast<double>(iterations_ * samples_ns_.size()); }
+};
+
+/**
+ * Keeps value (and whatever produced it) from being optimized away
+ */
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename T>
+inline void do_not_optimize(T &value)
+{
+  asm volatile("" : "+m"(value) : : "memory");
+}
+
+/**
+ * Forces pending writes to memory to be treated as observable
+ */
+inline void clobber_memory()
+{
+  asm volatile("" : : : "memory");
+}
+
+namespace detail
+{
+
+// Fills in the statistics from samples_ns_
+void summarize(BenchmarkResult &result);
+
+// Calls body() iterations times and returns the elapsed time
+template <typename F>
+std::chrono::nanoseconds time_batch(F &body, std::uint64_t iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t i = 0; i < iterations; ++i)
+  {
+    body();
+  }
+  return std::chrono::steady_clock::now() - start;
+}
+
+template <typename F>
+BenchmarkResult measure(std::string name, F &body, const BenchmarkOptions &options)
+{
+  BenchmarkResult result;
+  result.name_ = std::move(name);
+
+  // Warm caches, branch predictors and the CPU clock before anything is recorded
+  const auto warm_until = std::chrono::steady_clock::now() + options.warmup_;
+  do
+  {
+    time_batch(body, 1);
+  } while (std::chrono::steady_clock::now() < warm_until);
+
+  // Calibrate: grow the batch until one sample is long enough to swamp clock overhead
+  std::uint64_t iterations = 1;
+  for (auto elapsed = time_batch(body, iterations); elapsed < options.min_sample_time_; elapsed = time_batch(body, iterations))
+  {
+    const double scale = elapsed.count() > 0 ? 1.2 * static_cast<double>(options.min_sample_time_.count()) / static_cast<double>(elapsed.count()) : 10.0;
+    iterations = static_cast<std::uint64_t>(static_cast<double>(iterations) * std::min(10.0, std::max(2.0, scale)));
+  }
+  result.iterations_ = iterations;
+
+  result.samples_ns_.reserve(options.samples_);
+  const utils::PerfCounts counters_start = utils::thread_perf_counts();
+  for (std::size_t s = 0; s < options.samples_; ++s)
+  {
+    result.samples_ns_.push_back(static_cast<double>(time_batch(body, iterations).count()) / static_cast<double>(iterations));
+  }
+  result.counters_ = utils::thread_perf_counts() - counters_start;
+  summarize(result);
+  return result;
+}
+
+} // namespace detail
+
+} // namespace tUnit
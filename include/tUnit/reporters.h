@@ -0,0 +1,105 @@
+#pragma once
+#include "tUnit/result_format.h"
+#include "tUnit/test_listener.h"
+#include "utils/xml_stream.h"
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace tUnit
+{
+
+// One <testcase> element; shared by the streaming reporter and the final grouped report
+void write_junit_testcase(utils::XmlStream &xml, const TestOutcome &outcome);
+
+/**
+ * Base for reporters that write text to stdout (empty path) or to a file
+ */
+class StreamReporter : public Listener
+{
+protected:
+  explicit StreamReporter(const std::string &path);
+  std::ostream &out() { return file_.is_open() ? file_ : *console_; }
+
+private:
+  std::ofstream file_;
+  std::ostream *console_;
+};
+
+/**
+ * One line per finished test, with its failures underneath
+ */
+class ConsoleReporter : public StreamReporter
+{
+public:
+  explicit ConsoleReporter(const std::string &path = {}) : StreamReporter(path) {}
+  void test_finished(const TestOutcome &outcome) override;
+};
+
+/**
+ * One JSON object per line: a test_end record per test and a run_end record with the totals
+ */
+class JsonLinesReporter : public StreamReporter
+{
+public:
+  explicit JsonLinesReporter(const std::string &path = {}) : StreamReporter(path) {}
+  void test_finished(const TestOutcome &outcome) override;
+  void run_finished(const Orchestrator &orchestrator) override;
+};
+
+/**
+ * Test Anything Protocol, version 13; the plan line comes last
+ */
+class TapReporter : public StreamReporter
+{
+public:
+  explicit TapReporter(const std::string &path = {});
+  void test_finished(const TestOutcome &outcome) override;
+  void run_finished(const Orchestrator &orchestrator) override;
+
+private:
+  std::size_t count_ = 0;
+};
+
+/**
+ * JUnit XML: testcases are appended as they finish, so a crashed run still leaves every
+ * finished test on disk; at the end of the run the file is rewritten grouped by suite.
+ * With failures_only (-f) passing testcases are left out of both.
+ */
+class JUnitReporter : public Listener
+{
+public:
+  explicit JUnitReporter(std::string path, bool failures_only = false) : path_(std::move(path)), failures_only_(failures_only) {}
+  void test_started(const Test &test) override;
+  void test_finished(const TestOutcome &outcome) override;
+  void run_finished(const Orchestrator &orchestrator) override;
+
+private:
+  std::string path_;
+  bool failures_only_;
+  std::unique_ptr<utils::XmlStream> partial_;
+};
+
+/**
+ * Binary results (see result_format.h), one record per finished test, flushed as it goes
+ */
+class BinaryReporter : public Listener
+{
+public:
+  explicit BinaryReporter(const std::string &path);
+  ~BinaryReporter() override;
+  void test_finished(const TestOutcome &outcome) override;
+  void run_finished(const Orchestrator &orchestrator) override;
+
+private:
+  void drain();
+
+  std::string path_;
+  std::FILE *file_ = nullptr;
+  result_format::Writer writer_;
+};
+
+} // namespace tUnit
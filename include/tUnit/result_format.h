@@ -0,0 +1,92 @@
+/**
+ * Compact binary results format (.tunr), written by --results and read by --merge and tunit-results
+ *
+ * Layout: "TUNR", u32 version, then records of { u8 type, u32 payload size, payload }, all
+ * integers little-endian. Strings are interned: a string record defines the next id (0, 1, ...)
+ * and test records refer to ids, so a suite name or a repeated failure message is stored once.
+ * Readers skip record types they do not know and ignore trailing payload bytes, so fields are
+ * added by appending them to a record. A file truncated mid-record still delivers every complete
+ * record before the cut, but read reports the truncation as an error. The reader works on one
+ * contiguous image, e.g. an mmap.
+ */
+#pragma once
+#include "tUnit/benchmark.h"
+#include "utils/allocation_tracker.h"
+#include "utils/byte_stream.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tUnit
+{
+namespace result_format
+{
+
+constexpr std::string_view magic = "TUNR";
+constexpr std::uint32_t version = 1;
+
+enum class RecordType : std::uint8_t
+{
+  string = 1, // payload: the bytes
+  // payload: u32 suite, u32 test, u64 assertions, u64 failed, u64 wall_ns, u32 count, count x u32 failure,
+  // then u64 user_ns, u64 system_ns, u32 benchmarks, each { u32 name, u64 iterations, u32 n, n x f64 sample_ns },
+  // then perf counts for the test and for each benchmark, each { u32 event mask, u64 per event in the mask },
+  // then u8 heap tracked, and if set u64 allocations, u64 bytes, u64 live bytes, u64 peak live bytes
+  // (fields missing from older files read as zero/empty)
+  test = 2,
+};
+
+/**
+ * One finished test; the views point into the writer's caller or the reader's input
+ */
+struct TestRecord
+{
+  std::string_view suite_;
+  std::string_view test_;
+  std::uint64_t assertions_ = 0;
+  std::uint64_t failed_ = 0;
+  std::uint64_t wall_ns_ = 0;
+  std::vector<std::string_view> failures_;
+  std::uint64_t user_ns_ = 0;
+  std::uint64_t system_ns_ = 0;
+  std::vector<BenchmarkResult> benchmarks_; // statistics are recomputed from the samples on read
+  utils::PerfCounts counters_;
+  utils::AllocationStats allocations_;
+};
+
+/**
+ * Encodes records into a byte buffer the caller drains; interned ids persist across drains
+ */
+class Writer
+{
+public:
+  Writer();
+
+  void add_test(const TestRecord &record);
+
+  const std::string &bytes() const { return out_.bytes(); }
+  void clear() { out_.clear(); }
+
+private:
+  std::uint32_t id(std::string_view text);
+  void record(RecordType type, const std::string &payload);
+
+  utils::ByteWriter out_;
+  utils::ByteWriter payload_;
+  std::unordered_map<std::string, std::uint32_t> ids_;
+};
+
+// Calls on_test for every test record; false (with a message in error) on a bad header, a corrupt
+// record or a truncated file
+bool read(std::string_view image, const std::function<void(const TestRecord &)> &on_test, std::string *error = nullptr);
+
+inline bool is_binary(std::string_view image)
+{
+  return image.substr(0, magic.size()) == magic;
+}
+
+} // namespace result_format
+} // namespace tUnit
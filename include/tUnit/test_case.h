@@ -1,8 +1,15 @@
 #pragma once
 #include "../evaluator.h"
+#include "assert_each.h"
 #include "assertion.h"
+#include "benchmark.h"
+#include "test_results.h"
+#include <chrono>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace tUnit
@@ -19,16 +26,47 @@ class Test
 public:
   Test(const std::string &suite_name, const std::string &name);
 
+  // Descriptions are taken by view: a literal never builds a std::string, and a passing
+  // assertion that is not retained (--retain) only updates counters
+  // Operands and the predicate are passed through by reference, never copied
   template <typename T, typename P, typename U>
-  void assert(const std::string &description, const T &lhs, P pred, const U &rhs);
-  void expect(const std::string &description, bool condition, bool expected = true);
+  void assert(std::string_view description, const T &lhs, P &&pred, const U &rhs);
+  void expect(std::string_view description, bool condition, bool expected = true);
+  // Lazy descriptions: describe() returns a std::string and is only called when the
+  // assertion is stored or reported, e.g. when it fails
+  template <typename D, typename T, typename P, typename U, typename = std::enable_if_t<std::is_invocable_r_v<std::string, D &>>>
+  void assert(D &&describe, const T &lhs, P &&pred, const U &rhs);
+  template <typename D, typename = std::enable_if_t<std::is_invocable_r_v<std::string, D &>>>
+  void expect(D &&describe, bool condition, bool expected = true);
+  // One assertion for pred(element) over a whole range, or pred(lhs[i], rhs[i]) over two ranges
+  // of equal length; a failure records the counts and the first failing indices with their values
+  template <typename R, typename P>
+  void assert_each(std::string_view description, const R &range, P &&pred);
+  template <typename L, typename P, typename R>
+  void assert_each(std::string_view description, const L &lhs, P &&pred, const R &rhs);
+  // Times body() (see BenchmarkOptions) and records the statistics with this test's results
+  template <typename F>
+  BenchmarkResult benchmark(const std::string &name, F &&body, const BenchmarkOptions &options = {});
+  // Fails unless body() allocates nothing on this thread; needs the tunit_alloc hooks linked
+  template <typename F>
+  void expect_no_allocations(std::string_view description, F &&body);
   const std::string &name() const;
   const std::string &suite_name() const;
+  const TestResults &results() const;
+  // Measured by run() around the registered body; zero for tests that never ran on their own
+  const TestTiming &timing() const;
+  std::chrono::nanoseconds wall_time() const;
 
 private:
+  template <typename D>
+  void log_lazy(D &describe, bool passed);
+  void check_no_allocations(std::string_view description, const utils::AllocationStats &stats);
+
   std::string suite_name_;
   std::string name_;
-  std::vector<std::string> assertion_ids_;
+  TestResults *results_ = nullptr; // handle into Orchestrator-owned storage, set once by get_test
+  TestTiming timing_;
+  bool reported_ = false; // a test_finished event has been sent
 
   friend class Orchestrator;
 };
@@ -42,16 +80,74 @@ namespace tUnit
 
 // Template implementation
 template <typename T, typename P, typename U>
-void Test::assert(const std::string &description, const T &lhs, P pred, const U &rhs)
+void Test::assert(std::string_view description, const T &lhs, P &&pred, const U &rhs)
 {
-  Evaluator evaluator(lhs, rhs, pred);
+  Evaluator evaluator(lhs, rhs, std::forward<P>(pred));
   bool result = evaluator();
 
-  Assertion assertion(description, result);
+  Orchestrator::instance().log_assertion(*results_, description, result);
+}
+
+template <typename D, typename T, typename P, typename U, typename>
+void Test::assert(D &&describe, const T &lhs, P &&pred, const U &rhs)
+{
+  Evaluator evaluator(lhs, rhs, std::forward<P>(pred));
+  log_lazy(describe, evaluator());
+}
+
+template <typename D, typename>
+void Test::expect(D &&describe, bool condition, bool expected)
+{
+  log_lazy(describe, condition == expected);
+}
+
+template <typename R, typename P>
+void Test::assert_each(std::string_view description, const R &range, P &&pred)
+{
+  const EachResult result = detail::check_each(range, pred);
+  auto describe = [&]() { return detail::describe_each(description, result); };
+  log_lazy(describe, result.passed());
+}
+
+template <typename L, typename P, typename R>
+void Test::assert_each(std::string_view description, const L &lhs, P &&pred, const R &rhs)
+{
+  const EachResult result = detail::check_each(lhs, pred, rhs);
+  auto describe = [&]() { return detail::describe_each(description, result); };
+  log_lazy(describe, result.passed());
+}
+
+template <typename D>
+void Test::log_lazy(D &describe, bool passed)
+{
+  Orchestrator &orchestrator = Orchestrator::instance();
+  if (passed && orchestrator.log_unretained_pass(*results_))
+  {
+    return;
+  }
+  const std::string description = describe();
+  orchestrator.log_assertion(*results_, description, passed);
+}
 
-  assertion_ids_.push_back(description);
+template <typename F>
+BenchmarkResult Test::benchmark(const std::string &name, F &&body, const BenchmarkOptions &options)
+{
+  TUNIT_SCOPED_TRACE("benchmark: " + name);
+  BenchmarkResult result = detail::measure(name, body, options);
+  Orchestrator::instance().log_benchmark(*results_, result);
+  return result;
+}
 
-  Orchestrator::instance().log_assertion(suite_name_, name_, std::move(assertion));
+template <typename F>
+void Test::expect_no_allocations(std::string_view description, F &&body)
+{
+  utils::AllocationStats stats;
+  {
+    utils::AllocationScope scope;
+    body();
+    stats = scope.stats();
+  }
+  check_no_allocations(description, stats);
 }
 
 } // namespace tUnit
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include "test_registry.h"
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tUnit
+{
+
+/**
+ * Selects tests by their "suite::test" name and tags
+ *
+ * Pattern forms:
+ *   [tag][other]  the test carries every listed tag
+ *   /regex/       ECMAScript regex searched in "suite::test"
+ *   anything else a glob matched against the whole "suite::test" ('*' and '?')
+ *
+ * A test is selected when it matches at least one include pattern (or none were given)
+ * and no exclude pattern.
+ */
+class TestFilter
+{
+public:
+  struct Pattern
+  {
+    enum class Kind
+    {
+      glob,
+      regex,
+      tags
+    };
+
+    Kind kind_;
+    std::string text_;
+    std::regex regex_;
+    TagMask tags_;
+  };
+
+  static bool glob_match(std::string_view pattern, std::string_view text);
+
+  // tags is the mask for a "[tag]" pattern, resolved by the caller against the tag table
+  void include(std::string_view pattern, TagMask tags = {});
+  void exclude(std::string_view pattern, TagMask tags = {});
+
+  bool empty() const { return includes_.empty() && excludes_.empty(); }
+  bool selects(std::string_view full_name, TagMask tags) const;
+
+private:
+  static Pattern compile(std::string_view pattern, TagMask tags);
+  static bool matches(const Pattern &pattern, std::string_view full_name, TagMask tags);
+
+  std::vector<Pattern> includes_;
+  std::vector<Pattern> excludes_;
+};
+
+} // namespace tUnit
@@ -0,0 +1,49 @@
+#pragma once
+#include "tUnit/test_results.h"
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace tUnit
+{
+
+class Orchestrator;
+class Test;
+
+/**
+ * Snapshot of one finished test, handed to listeners when the test ends
+ */
+struct TestOutcome
+{
+  const Test &test_;
+  std::size_t assertions_ = 0;
+  std::size_t failed_ = 0;
+  std::vector<std::string_view> failures_; // descriptions of the stored failed assertions, in log order
+  TestTiming timing_;
+  std::vector<BenchmarkResult> benchmarks_;
+
+  bool passed() const { return failed_ == 0; }
+};
+
+/**
+ * Receives run events as they happen; register with Orchestrator::add_listener before run()
+ *
+ * Events are serialized, so a listener never sees two calls at once, but they may arrive
+ * from different threads. Tests running in parallel interleave their events.
+ */
+class Listener
+{
+public:
+  virtual ~Listener() = default;
+
+  // assertion_logged is only called on listeners returning true (read once, by add_listener):
+  // per-assertion events serialize every asserting thread, and lazy descriptions are built for them
+  virtual bool wants_assertions() const { return false; }
+
+  virtual void test_started(const Test &) {}
+  virtual void assertion_logged(const Test &, std::string_view /*description*/, bool /*passed*/) {}
+  virtual void test_finished(const TestOutcome &) {}
+  virtual void run_finished(const Orchestrator &) {}
+};
+
+} // namespace tUnit
@@ -1,8 +1,19 @@
 #pragma once
+#include "tUnit/test_filter.h"
+#include "tUnit/test_listener.h"
+#include "tUnit/test_registry.h"
+#include "tUnit/test_results.h"
+#include "utils/string_arena.h"
 #include "utils/trace_support.h"
+#include "utils/watchdog.h"
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tUnit
@@ -12,49 +23,210 @@ class Suite;
 class Test;
 class Assertion;
 
+/**
+ * Which assertions are stored after their counters have been updated
+ */
+enum class Retention
+{
+  all,                // every assertion is stored
+  failures,           // only failed assertions are stored
+  failures_and_first, // failures plus the first pass_limit passing assertions of each test
+};
+
 /**
  * Central instance that orchestrates test execution and result collection
+ *
+ * Registration is serialized by a mutex. Assertions are recorded into a per-thread shard,
+ * so threads never contend with each other; shards are merged into the per-test, per-suite
+ * and global views whenever results are read.
  */
 class Orchestrator
 {
 public:
   static Orchestrator &instance();
 
+  // Exit status of a run stopped by a test timeout (as with coreutils timeout)
+  static constexpr int exit_timed_out = 124;
+
   void parse_args(int argc, char *argv[]);
 
-  Suite &get_suite(const std::string &name);
-  Test &get_test(const std::string &suite_name, const std::string &test_name);
-  void log_assertion(const std::string &suite_name, const std::string &test_name, Assertion &&assertion);
+  // Registered tests only execute when run() is called (after parse_args)
+  void register_test(std::string suite_name, std::string test_name, std::function<void(Test &)> body, std::string_view tags = {},
+                     double timeout = 0);
+  // TUNIT_STATIC_ASSERT results; each source file's checks (keyed by its __FILE__ path) run as one registered test
+  void register_static_assertion(std::string_view file, int line, std::string_view expression, bool passed);
+  const std::vector<TestRegistration> &registrations() const;
+  // Listeners receive events from run(); not thread-safe, add them before running
+  void add_listener(std::unique_ptr<Listener> listener);
+
+  void run();                // uses -j (default 1)
+  void run(size_t jobs);     // 0 = one worker per hardware thread
+  void list_tests() const;
+
+  // Tags are written "[name]"; each distinct name gets one bit of a TagMask
+  TagMask tag_mask(std::string_view tags);
+  std::string tag_names(TagMask tags) const;
+  TestFilter &filter();
+
+  Suite &get_suite(std::string_view name);
+  Test &get_test(std::string_view suite_name, std::string_view test_name);
+  void log_assertion(TestResults &results, Assertion &&assertion);
+  void log_assertion(TestResults &results, std::string_view description, bool passed);
+  void log_assertion(std::string_view suite_name, std::string_view test_name, Assertion &&assertion);
+  // Counts a passing assertion without its description when it would be neither stored nor
+  // reported to a listener that wants assertions; false if the caller must log it with log_assertion instead
+  bool log_unretained_pass(TestResults &results);
+  // Records a benchmark and, with --compare-baseline, fails an assertion if it regressed
+  void log_benchmark(TestResults &results, const BenchmarkResult &benchmark);
+  // Counts passing assertions whose descriptions are not available, e.g. results merged from another process
+  void log_passed(TestResults &results, size_t count);
+
+  // Replays a results file into this run: binary (--results) or a JUnit report written by
+  // write_xml_output, e.g. one shard's output; the format is detected from the contents
+  bool load_results(const std::string &path);
+  bool load_xml_results(const std::string &path);
+  // Loads every file, then finishes the run as if the tests had executed here; false if any
+  // file could not be read completely, which also fails the run (all_tests_passed)
+  bool merge(const std::vector<std::string> &paths);
+
+  // Merges every thread's pending results; called by all result readers below
+  void collect() const;
+
+  // Not synchronized with logging: configure before tests start asserting
+  void set_retention(Retention retention, size_t pass_limit = 0);
+  Retention retention() const;
+  size_t pass_limit() const;
 
   bool all_tests_passed() const;
   size_t total_assertions() const;
   size_t failed_assertions() const;
+  size_t failed_tests() const;
+  const ResultCounters &counters() const;
   void print_summary() const;
 
   void write_xml_output() const;
+  bool write_junit(const std::string &path) const;
 
-  const std::unordered_map<std::string, std::unique_ptr<Suite>> &suites() const;
+  const std::unordered_map<std::string_view, std::unique_ptr<Suite>> &suites() const;
   const std::unordered_map<std::string, std::unique_ptr<Test>> &tests() const;
-  const std::vector<Assertion> &assertions_for(const std::string &suite_name, const std::string &test_name) const;
+  const std::vector<Suite *> &suite_order() const; // creation order, used for deterministic reports
+  const std::vector<Assertion> &assertions_for(std::string_view suite_name, std::string_view test_name) const;
 
 private:
   Orchestrator() = default;
   ~Orchestrator();
 
+  struct ResultShard;
+  ResultShard &local_shard();
+
+  void collect_locked() const;
+  // Collects, then hands over the sorted slot indices of every test with results collected since
+  // the last call; only tracked in an --isolate worker
+  void take_collected_slots_locked(std::vector<size_t> &slots) const;
+  Suite &suite_for(std::string_view name);
+  Test &test_for(Suite &suite, std::string_view test_name);
+  Test &get_test(Suite &suite, std::string_view test_name);
+  void run_test(const TestRegistration &registration, Test &test);
+  // Seconds, 0 = none: the registration's own timeout, else --timeout
+  double timeout_for(const TestRegistration &registration) const;
+  bool has_timeouts(const std::vector<size_t> &selected) const;
+  // Runs on the watchdog thread at the test's deadline. Returns if finished was already set (the
+  // test beat its deadline); otherwise sets it, reports the test as timed out and exits
+  void on_timeout(Test &test, std::atomic<bool> &finished, const trace::TraceStack &stack, double seconds,
+                  std::chrono::steady_clock::time_point started);
+  void notify_test_started(const Test &test);
+  void notify_assertion(const TestResults &results, std::string_view description, bool passed);
+  void notify_test_finished(Test &test);
+  void notify_run_finished();
+  TestOutcome outcome_locked(const Test &test) const;
+  void store_benchmark(TestResults &results, const BenchmarkResult &benchmark);
+
+  // --save-baseline / --compare-baseline, keyed by suite::test::benchmark
+  bool load_baseline(const std::string &path);
+  void save_baseline() const;
+  void compare_to_baseline(TestResults &results, const BenchmarkResult &benchmark);
+  void replay(Test &test, size_t passes, const std::vector<std::string_view> &failures, const TestTiming &timing,
+              const std::vector<BenchmarkResult> &benchmarks);
+  // --isolate: runs each selected test in a pre-forked worker process
+  void run_isolated(const std::vector<size_t> &selected, const std::vector<Test *> &tests, size_t workers);
+
   // non-copyable/movable
   Orchestrator(const Orchestrator &) = delete;
   Orchestrator(Orchestrator &&) = delete;
   Orchestrator &operator=(const Orchestrator &) = delete;
   Orchestrator &operator=(Orchestrator &&) = delete;
 
-  std::unordered_map<std::string, std::unique_ptr<Suite>> suites_;
+  // Suites are keyed by views into their own name, so lookups never allocate
+  std::unordered_map<std::string_view, std::unique_ptr<Suite>> suites_;
+  std::vector<Suite *> suite_order_;
   std::unordered_map<std::string, std::unique_ptr<Test>> tests_;
-  std::unordered_map<std::string, std::vector<Assertion>> assertions_;
+  // Node-based map: TestResults addresses stay valid for the lifetime of the handles given to tests
+  std::unordered_map<std::string, TestResults> results_;
+  std::vector<TestResults *> results_by_slot_;
+  mutable ResultCounters counters_;
+
+  // Guards registration and the shard list; never held while a shard appends
+  mutable std::mutex registry_mutex_;
+  // One shard per thread that has logged
+  std::vector<std::unique_ptr<ResultShard>> shards_;
+  // Every stored assertion's description, one copy per distinct text across all threads
+  utils::StringInterner descriptions_;
+  static thread_local ResultShard *local_shard_;
+
+  std::vector<TestRegistration> registrations_;
+  // Node-based: each registered test's body refers to its file's list
+  std::unordered_map<std::string, std::vector<std::pair<std::string, bool>>> static_assertions_;
+  std::vector<std::string> tag_names_; // index = bit in TagMask
+  TestFilter filter_;
+
+  std::vector<size_t> selected_registrations() const;
+  void select_shard(std::vector<size_t> &selected) const;
+  bool load_shard_timings(const std::string &path);
+  void write_timings(const std::vector<Test *> &tests) const;
+  std::string xml_output_path() const;
+  void print_slowest() const;
+  std::string shard_path(std::string path) const;
+  TagMask tag_mask_locked(std::string_view tags);
 
   std::string xml_output_path_;
   bool failures_only_ = false;
+  bool list_only_ = false;
+  size_t jobs_ = 1;
+  size_t slowest_ = 0; // --slowest N: list the N longest tests after the summary
+  bool isolate_ = false;
+  double test_timeout_ = 0;    // --timeout: seconds per test, 0 = none
+  utils::Watchdog *watchdog_ = nullptr; // set while tests run in this process with a timeout
+  bool worker_process_ = false;         // an --isolate worker: on timeout just exit, the parent reports
+  mutable std::vector<size_t> collected_slots_; // worker only, see take_collected_slots_locked
+  size_t memory_limit_mb_ = 0; // RLIMIT_AS per worker process, 0 = none
+  bool fail_leaks_ = false;    // --fail-leaks: every test fails on a leak, not just [leaks] ones
+  TagMask leak_tag_;           // [leaks], resolved when the run starts
+
+  // --shard-index/--shard-count split registered tests across processes
+  size_t shard_index_ = 0;
+  size_t shard_count_ = 1;
+  std::unordered_map<std::string, double> shard_timings_; // suite::test -> seconds, from --shard-timings
+  std::string timings_output_path_;
+  std::string results_output_path_; // --results: binary results file
+  std::string save_baseline_path_;
+  std::unordered_map<std::string, BenchmarkResult> baseline_;
+  double regression_threshold_ = 0.05; // slower median than this fraction counts as a regression...
+  double regression_alpha_ = 0.01;     // ...if the Mann-Whitney p-value is below this
+  std::vector<std::string> merge_inputs_;
+  std::vector<std::string> unreadable_results_; // merge inputs that were missing, corrupt or truncated
+  // Read on every logged assertion from any thread
+  std::atomic<Retention> retention_{Retention::all};
+  std::vector<std::unique_ptr<Listener>> listeners_;
+  std::atomic<bool> has_listeners_{false}; // checked before any event is built or dispatched
+  std::vector<Listener *> assertion_listeners_; // those whose wants_assertions() is true
+  std::atomic<bool> has_assertion_listeners_{false};
+  std::mutex listener_mutex_;              // serializes events
+  bool run_finished_ = false;
+  std::atomic<size_t> pass_limit_{0};
 
   static Orchestrator *instance_;
+
+  friend class Suite;
 };
 
 } // namespace tUnit
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include "evaluator.h"
+#include "predicates/predicate_config.h"
+#include <bitset>
+#include <functional>
+#include <string>
+
+namespace tUnit
+{
+
+class Test;
+
+// One bit per distinct tag name, assigned by the Orchestrator on first use
+using TagMask = std::bitset<64>;
+
+/**
+ * A test recorded at static-initialization time and executed later by Orchestrator::run()
+ */
+struct TestRegistration
+{
+  std::string suite_name_;
+  std::string test_name_;
+  std::function<void(Test &)> body_;
+  TagMask tags_;
+  double timeout_ = 0; // seconds; 0 = the --timeout default
+};
+
+/**
+ * Static helper behind TUNIT_TEST: records the test body with the Orchestrator, runs nothing
+ */
+struct Registrar
+{
+  Registrar(void (*body)(Test &), const char *suite_name, const char *test_name, const char *tags = "", double timeout = 0);
+};
+
+/**
+ * Static helper behind TUNIT_STATIC_ASSERT: reports a check the compiler has already decided
+ * (TUNIT_MODE=1), or one evaluated during static initialization (TUNIT_MODE=0)
+ */
+struct StaticAssertionRegistrar
+{
+  StaticAssertionRegistrar(const char *file, int line, const char *expression, bool passed);
+};
+
+} // namespace tUnit
+
+#define TUNIT_CONCAT_IMPL(a, b) a##b
+#define TUNIT_CONCAT(a, b) TUNIT_CONCAT_IMPL(a, b)
+
+/**
+ * Registers a test body; `test` is the tUnit::Test the body asserts against
+ * Arguments: suite name, test name, an optional tag string such as "[slow][bench]" and an
+ * optional timeout in seconds that overrides --timeout for this test
+ *
+ *   TUNIT_TEST("Suite Name", "Test Name", "[slow]", 30)
+ *   {
+ *     test.assert("5 is_equal 5", 5, pred::is_equal{}, 5);
+ *   }
+ */
+#define TUNIT_TEST(...)                                                                                            \
+  static void TUNIT_CONCAT(tunit_test_body_, __LINE__)(tUnit::Test & test);                                        \
+  static const tUnit::Registrar TUNIT_CONCAT(tunit_registrar_, __LINE__)(&TUNIT_CONCAT(tunit_test_body_, __LINE__), \
+                                                                         __VA_ARGS__);                              \
+  static void TUNIT_CONCAT(tunit_test_body_, __LINE__)([[maybe_unused]] tUnit::Test & test)
+
+/**
+ * Checks pred(lhs, rhs) on constant operands, at namespace scope
+ * With TUNIT_MODE=1 (Release) the predicates are constexpr and a false check fails the build;
+ * with TUNIT_MODE=0 it is evaluated at startup instead. Either way the check is reported as a
+ * passing or failing assertion of the test "Static Assertions::<source file>" (tag [static]),
+ * named by the path in __FILE__ (-fmacro-prefix-map shortens it to one relative to the sources).
+ *
+ *   TUNIT_STATIC_ASSERT(pred::is_less{}, 1, 2);
+ */
+#if TUNIT_MODE
+#define TUNIT_STATIC_ASSERT(pred, lhs, rhs)                                                                              \
+  static_assert(tUnit::Evaluator((lhs), (rhs), (pred))(), "TUNIT_STATIC_ASSERT(" #pred ", " #lhs ", " #rhs ") is false"); \
+  static const tUnit::StaticAssertionRegistrar TUNIT_CONCAT(tunit_static_assert_, __LINE__)(                            \
+      __FILE__, __LINE__, "TUNIT_STATIC_ASSERT(" #pred ", " #lhs ", " #rhs ")", true)
+#else
+#define TUNIT_STATIC_ASSERT(pred, lhs, rhs)                                                   \
+  static const tUnit::StaticAssertionRegistrar TUNIT_CONCAT(tunit_static_assert_, __LINE__)( \
+      __FILE__, __LINE__, "TUNIT_STATIC_ASSERT(" #pred ", " #lhs ", " #rhs ")", tUnit::Evaluator((lhs), (rhs), (pred))())
+#endif
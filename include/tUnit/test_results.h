@@ -0,0 +1,62 @@
+#pragma once
+#include "assertion.h"
+#include "benchmark.h"
+#include "utils/allocation_tracker.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace tUnit
+{
+
+class Test;
+
+/**
+ * Running pass/fail totals, kept for the whole run and for each suite
+ */
+struct ResultCounters
+{
+  std::size_t assertions_ = 0;
+  std::size_t failed_assertions_ = 0;
+  std::size_t failed_tests_ = 0;
+};
+
+/**
+ * What one run of a test body cost: monotonic wall clock plus the running thread's CPU time,
+ * and hardware counters and heap allocations when those are being collected
+ */
+struct TestTiming
+{
+  std::chrono::nanoseconds wall_{0};
+  std::chrono::nanoseconds user_{0};
+  std::chrono::nanoseconds system_{0};
+  utils::PerfCounts counters_; // --perf-counters
+  utils::AllocationStats allocations_; // with the tunit_alloc hooks linked
+};
+
+/**
+ * Result storage for a single test, owned by the Orchestrator and reached through a stable handle
+ */
+class TestResults
+{
+public:
+  std::vector<Assertion> assertions_;
+  std::vector<std::size_t> failures_; // indices into assertions_ of the failed ones, in log order
+  std::vector<BenchmarkResult> benchmarks_;
+
+  std::size_t total_ = 0;
+  std::size_t failed_ = 0;
+
+  bool passed() const { return failed_ == 0; }
+
+private:
+  ResultCounters *suite_counters_ = nullptr;
+  std::atomic<std::size_t> passes_seen_{0}; // across all threads, drives Retention::failures_and_first
+  std::size_t slot_ = 0; // index of this test's slot in every per-thread shard
+  const Test *test_ = nullptr;
+
+  friend class Orchestrator;
+};
+
+} // namespace tUnit
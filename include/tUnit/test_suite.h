@@ -1,5 +1,7 @@
 #pragma once
+#include "test_results.h"
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -16,13 +18,18 @@ class Suite
 public:
   Suite(const std::string &name);
 
-  Test &get_test(const std::string &test_name);
+  Test &get_test(std::string_view test_name);
 
   const std::string &name() const;
+  const ResultCounters &counters() const;
+  const std::vector<Test *> &test_order() const; // creation order, used for deterministic reports
 
 private:
   std::string name_;
-  std::unordered_map<std::string, Test *> tests_;
+  // Keyed by views into each Test's own name
+  std::unordered_map<std::string_view, Test *> tests_;
+  std::vector<Test *> test_order_;
+  ResultCounters counters_;
 
   friend class Orchestrator;
 };
@@ -0,0 +1,113 @@
+/**
+ * Heap allocation accounting for the running test
+ *
+ * The counting lives here; the operator new/delete replacements that feed it are in the
+ * tunit_alloc object library, so only binaries that link it pay for (and get) tracking.
+ * Allocations are charged to the calling thread's innermost AllocationScope and tagged with
+ * its outermost one, so a block freed on another thread (a std::thread's state, a queue
+ * drained by a worker) is still credited. Memory a test allocates on threads it starts
+ * itself is not counted, and frees of blocks from before the scope are ignored.
+ */
+#pragma once
+
+#include "utils/byte_stream.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace tUnit
+{
+namespace utils
+{
+
+struct AllocationStats
+{
+  bool tracked_ = false; // the hooks were linked, so the numbers mean something
+  std::uint64_t allocations_ = 0;
+  std::uint64_t bytes_ = 0;         // total allocated, as requested sizes
+  std::int64_t live_bytes_ = 0;     // allocated minus freed
+  std::int64_t peak_live_bytes_ = 0;
+
+  // Still allocated when the scope ended
+  std::uint64_t leaked_bytes() const { return live_bytes_ > 0 ? static_cast<std::uint64_t>(live_bytes_) : 0; }
+};
+
+namespace allocation_tracking
+{
+
+// Called by the hooks; noexcept and allocation-free. record_allocation returns the owner tag
+// the hook keeps with the block (0: not tracked) and hands back to record_free.
+std::uint64_t record_allocation(std::size_t size) noexcept;
+void record_free(std::uint64_t owner, std::size_t size) noexcept;
+void mark_available() noexcept;
+
+bool available() noexcept;
+
+} // namespace allocation_tracking
+
+/**
+ * Counts this thread's allocations while alive; an inner scope's counts are added to the
+ * enclosing one when it ends
+ */
+class AllocationScope
+{
+public:
+  AllocationScope() noexcept;
+  ~AllocationScope();
+
+  AllocationScope(const AllocationScope &) = delete;
+  AllocationScope &operator=(const AllocationScope &) = delete;
+
+  // Counts so far, including frees on other threads seen up to now
+  const AllocationStats &stats();
+
+private:
+  AllocationStats stats_;
+  AllocationStats *outer_;
+  std::uint64_t owner_ = 0; // outermost scope of a thread only: its tag, with its owner slot in the low byte
+};
+
+/**
+ * Framework bookkeeping called from a test body (logging an assertion, interning its
+ * description) is not charged to the test
+ */
+class AllocationPause
+{
+public:
+  AllocationPause() noexcept;
+  ~AllocationPause();
+
+  AllocationPause(const AllocationPause &) = delete;
+  AllocationPause &operator=(const AllocationPause &) = delete;
+};
+
+// Wire form: u8 tracked, then u64 allocations, bytes, live and peak bytes when tracked
+inline void put_allocations(ByteWriter &out, const AllocationStats &stats)
+{
+  out.u8(stats.tracked_ ? 1 : 0);
+  if (stats.tracked_)
+  {
+    out.u64(stats.allocations_);
+    out.u64(stats.bytes_);
+    out.u64(static_cast<std::uint64_t>(stats.live_bytes_));
+    out.u64(static_cast<std::uint64_t>(stats.peak_live_bytes_));
+  }
+}
+
+inline bool get_allocations(ByteReader &in, AllocationStats &stats)
+{
+  stats = {};
+  std::uint8_t tracked = 0;
+  std::uint64_t live = 0, peak = 0;
+  if (!in.u8(tracked) || (tracked != 0 && !(in.u64(stats.allocations_) && in.u64(stats.bytes_) && in.u64(live) && in.u64(peak))))
+  {
+    stats = {};
+    return false;
+  }
+  stats.tracked_ = tracked != 0;
+  stats.live_bytes_ = static_cast<std::int64_t>(live);
+  stats.peak_live_bytes_ = static_cast<std::int64_t>(peak);
+  return true;
+}
+
+} // namespace utils
+} // namespace tUnit
@@ -0,0 +1,125 @@
+/**
+ * Little-endian, length-prefixed encoding for results that cross a process boundary
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace tUnit
+{
+namespace utils
+{
+
+/**
+ * Appends fixed-width integers and u32-length-prefixed strings to a byte string
+ */
+class ByteWriter
+{
+public:
+  void u8(std::uint8_t value) { bytes_.push_back(static_cast<char>(value)); }
+  void u32(std::uint32_t value) { put(value, 4); }
+  void u64(std::uint64_t value) { put(value, 8); }
+  void f64(double value)
+  {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    u64(bits);
+  }
+
+  void str(std::string_view value)
+  {
+    u32(static_cast<std::uint32_t>(value.size()));
+    bytes_.append(value.data(), value.size());
+  }
+
+  const std::string &bytes() const { return bytes_; }
+  std::string &bytes() { return bytes_; }
+  void clear() { bytes_.clear(); }
+
+private:
+  void put(std::uint64_t value, int width)
+  {
+    for (int i = 0; i < width; ++i)
+    {
+      bytes_.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+  }
+
+  std::string bytes_;
+};
+
+/**
+ * Reads what ByteWriter wrote; every read fails (returns false) instead of running past the end
+ */
+class ByteReader
+{
+public:
+  explicit ByteReader(std::string_view bytes) : bytes_(bytes) {}
+
+  bool u8(std::uint8_t &value)
+  {
+    std::uint64_t wide = 0;
+    bool ok = get(wide, 1);
+    value = static_cast<std::uint8_t>(wide);
+    return ok;
+  }
+
+  bool u32(std::uint32_t &value)
+  {
+    std::uint64_t wide = 0;
+    bool ok = get(wide, 4);
+    value = static_cast<std::uint32_t>(wide);
+    return ok;
+  }
+
+  bool u64(std::uint64_t &value) { return get(value, 8); }
+
+  bool f64(double &value)
+  {
+    std::uint64_t bits = 0;
+    bool ok = get(bits, 8);
+    std::memcpy(&value, &bits, sizeof(value));
+    return ok;
+  }
+
+  // The view points into the reader's input
+  bool str(std::string_view &value)
+  {
+    std::uint32_t size = 0;
+    if (!u32(size) || size > remaining())
+    {
+      return false;
+    }
+    value = bytes_.substr(pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  size_t remaining() const { return bytes_.size() - pos_; }
+  size_t position() const { return pos_; }
+
+private:
+  bool get(std::uint64_t &value, size_t width)
+  {
+    if (remaining() < width)
+    {
+      return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < width; ++i)
+    {
+      value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes_[pos_ + i])) << (8 * i);
+    }
+    pos_ += width;
+    return true;
+  }
+
+  std::string_view bytes_;
+  size_t pos_ = 0;
+};
+
+} // namespace utils
+} // namespace tUnit
@@ -0,0 +1,35 @@
+/**
+ * CPU time consumed by the calling thread
+ */
+#pragma once
+
+#include <chrono>
+#include <sys/resource.h>
+
+namespace tUnit
+{
+namespace utils
+{
+
+struct CpuTime
+{
+  std::chrono::nanoseconds user_{0};
+  std::chrono::nanoseconds system_{0};
+};
+
+// One getrusage call; threads a test starts itself are not included
+inline CpuTime thread_cpu_time() noexcept
+{
+  rusage usage{};
+#ifdef RUSAGE_THREAD
+  ::getrusage(RUSAGE_THREAD, &usage);
+#else
+  ::getrusage(RUSAGE_SELF, &usage);
+#endif
+  auto to_ns = [](const timeval &tv)
+  { return std::chrono::seconds(tv.tv_sec) + std::chrono::microseconds(tv.tv_usec); };
+  return {to_ns(usage.ru_utime), to_ns(usage.ru_stime)};
+}
+
+} // namespace utils
+} // namespace tUnit
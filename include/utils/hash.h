@@ -0,0 +1,27 @@
+/**
+ * Stable, platform-independent hashing for values that must agree across processes and machines
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace tUnit
+{
+namespace utils
+{
+
+// 64-bit FNV-1a; unlike std::hash, the result is fixed for a given input everywhere
+constexpr std::uint64_t fnv1a(std::string_view text) noexcept
+{
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : text)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+} // namespace utils
+} // namespace tUnit
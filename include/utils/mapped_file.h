@@ -0,0 +1,35 @@
+/**
+ * Read-only memory mapping of a whole file
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace tUnit
+{
+namespace utils
+{
+
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool is_open() const { return opened_; }
+  // Valid while this object lives; empty for an empty file
+  std::string_view bytes() const { return {static_cast<const char *>(data_), size_}; }
+
+private:
+  void *data_ = nullptr;
+  std::size_t size_ = 0;
+  bool opened_ = false;
+};
+
+} // namespace utils
+} // namespace tUnit
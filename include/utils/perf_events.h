@@ -0,0 +1,91 @@
+/**
+ * Hardware performance counters for the calling thread, read through perf_event_open
+ *
+ * Off unless enabled (--perf-counters). Each thread opens one counter group on first use;
+ * events the kernel refuses (no PMU in a VM or container, perf_event_paranoid, seccomp) are
+ * left out, and with none available every reading is empty.
+ */
+#pragma once
+
+#include "utils/byte_stream.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tUnit
+{
+namespace utils
+{
+
+struct PerfCounts
+{
+  enum Event : std::uint8_t
+  {
+    cycles,
+    instructions,
+    branch_misses,
+    l1d_misses,
+    llc_misses,
+    page_faults,
+    event_count
+  };
+
+  static constexpr std::array<std::string_view, event_count> names = {
+      "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses", "page_faults"};
+
+  std::array<std::uint64_t, event_count> values_{};
+  std::uint32_t available_ = 0; // bit per Event; an event the kernel would not count is absent, not zero
+
+  bool any() const { return available_ != 0; }
+  bool has(Event event) const { return (available_ >> event) & 1u; }
+  std::uint64_t operator[](Event event) const { return values_[event]; }
+};
+
+// Counts accumulated between two readings of the same group
+PerfCounts operator-(const PerfCounts &end, const PerfCounts &start);
+
+// Turns counting on for threads that have not read yet; call before tests start
+void enable_perf_counters();
+bool perf_counters_enabled();
+
+// Running totals of the calling thread's group; empty when disabled or unavailable
+PerfCounts thread_perf_counts();
+
+// "instructions 1.2e+06, cycles 9.8e+05 (IPC 1.22), ..." with every value divided by per
+std::string format_counts(const PerfCounts &counts, double per = 1);
+
+// Wire form: u32 available mask, then one u64 per available event
+inline void put_counts(ByteWriter &out, const PerfCounts &counts)
+{
+  out.u32(counts.available_);
+  for (int event = 0; event < PerfCounts::event_count; ++event)
+  {
+    if (counts.has(static_cast<PerfCounts::Event>(event)))
+    {
+      out.u64(counts.values_[event]);
+    }
+  }
+}
+
+inline bool get_counts(ByteReader &in, PerfCounts &counts)
+{
+  counts = {};
+  if (!in.u32(counts.available_))
+  {
+    return false;
+  }
+  counts.available_ &= (1u << PerfCounts::event_count) - 1;
+  for (int event = 0; event < PerfCounts::event_count; ++event)
+  {
+    if (counts.has(static_cast<PerfCounts::Event>(event)) && !in.u64(counts.values_[event]))
+    {
+      counts = {};
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace utils
+} // namespace tUnit
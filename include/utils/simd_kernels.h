@@ -0,0 +1,103 @@
+/**
+ * Vectorized kernels behind the container predicates for contiguous ranges of arithmetic types
+ *
+ * Each kernel is compiled for SSE2 (the x86-64 baseline), AVX2 and AVX-512; the widest one the
+ * CPU supports is picked once, by CPUID, on first use. Every level evaluates exactly the
+ * element comparisons of the std algorithm it replaces (==, <, >, and x % 2 on integers), so
+ * results are identical to the generic path, including for NaN and signed zeros.
+ */
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace tUnit
+{
+namespace utils
+{
+namespace simd
+{
+
+enum class Level
+{
+  baseline, // SSE2 on x86-64, plain C++ elsewhere
+  avx2,
+  avx512,
+};
+
+// Detected once; every kernel uses it unless given a level explicitly
+Level best_level();
+const char *level_name(Level level);
+
+// Unary element checks with a kernel: the built-in numeric predicates
+enum class ElementTest
+{
+  positive,
+  negative,
+  zero,
+  even, // integral types only
+  odd,  // integral types only
+};
+
+// Element types with kernels: every standard integer type except bool, float and double
+template <typename T>
+constexpr bool is_kernel_type_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double> &&
+                                  !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+namespace detail
+{
+
+template <typename C, typename = void>
+struct contiguous_element
+{
+  using type = void;
+};
+
+// Ranges with data() and size() whose data() points at their elements (vector, array, span, string)
+template <typename C>
+struct contiguous_element<C, std::void_t<decltype(std::data(std::declval<const C &>())), decltype(std::size(std::declval<const C &>()))>>
+{
+  using type = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<const C &>()))>>;
+};
+
+} // namespace detail
+
+// The element type of C if C is a contiguous range with kernels for it, else void
+template <typename C>
+using kernel_element_t = std::conditional_t<is_kernel_type_v<typename detail::contiguous_element<std::remove_cv_t<C>>::type>,
+                                            typename detail::contiguous_element<std::remove_cv_t<C>>::type, void>;
+
+template <typename C>
+constexpr bool has_kernels_v = !std::is_void_v<kernel_element_t<C>>;
+
+// Index of the first element equal to value, or n (std::find)
+template <typename T>
+std::size_t find(const T *data, std::size_t n, T value, Level level = best_level());
+
+// Whether no element is less than its predecessor, or with descending greater (std::is_sorted)
+template <typename T>
+bool is_sorted(const T *data, std::size_t n, bool descending, Level level = best_level());
+
+// Whether lhs[i] == rhs[i] for every i (std::equal)
+template <typename T>
+bool equal(const T *lhs, const T *rhs, std::size_t n, Level level = best_level());
+
+// Number of elements passing test (std::count_if)
+template <typename T>
+std::size_t count(const T *data, std::size_t n, ElementTest test, Level level = best_level());
+
+// Index of the first element whose test result is expected, or n (std::find_if / find_if_not)
+template <typename T>
+std::size_t find_test(const T *data, std::size_t n, ElementTest test, bool expected, Level level = best_level());
+
+} // namespace simd
+} // namespace utils
+} // namespace tUnit
+
+// Kernels are out-of-line calls; constant evaluation (TUNIT_STATIC_ASSERT) keeps the std algorithms
+#if defined(__GNUC__) || defined(__clang__)
+#define TUNIT_SIMD_RUNTIME() (!__builtin_is_constant_evaluated())
+#else
+#define TUNIT_SIMD_RUNTIME() false
+#endif
@@ -0,0 +1,38 @@
+/**
+ * Minimal test-and-test-and-set spin lock for short, mostly uncontended critical sections
+ */
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+namespace tUnit
+{
+namespace utils
+{
+
+/**
+ * Satisfies BasicLockable, so it works with std::lock_guard
+ */
+class SpinLock
+{
+public:
+  void lock() noexcept
+  {
+    while (locked_.exchange(true, std::memory_order_acquire))
+    {
+      while (locked_.load(std::memory_order_relaxed))
+      {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void unlock() noexcept { locked_.store(false, std::memory_order_release); }
+
+private:
+  std::atomic<bool> locked_{false};
+};
+
+} // namespace utils
+} // namespace tUnit
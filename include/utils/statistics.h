@@ -0,0 +1,24 @@
+/**
+ * Small nonparametric statistics for comparing benchmark samples
+ */
+#pragma once
+
+#include <vector>
+
+namespace tUnit
+{
+namespace utils
+{
+
+/**
+ * One-sided Mann-Whitney U test: the probability, if both sets come from the same
+ * distribution, of candidate being at least this much larger than baseline.
+ * Exact for small samples without ties, normal approximation (tie- and continuity-corrected)
+ * otherwise. Returns 1 when either set is empty.
+ */
+double mann_whitney_greater_p(const std::vector<double> &baseline, const std::vector<double> &candidate);
+
+double median(std::vector<double> values);
+
+} // namespace utils
+} // namespace tUnit
@@ -0,0 +1,100 @@
+/**
+ * Bump-pointer string storage and a thread-safe interning table built on top of it
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace tUnit
+{
+namespace utils
+{
+
+/**
+ * Append-only character storage; everything is released at once when the arena is destroyed
+ */
+class StringArena
+{
+public:
+  static constexpr std::size_t block_size = 64 * 1024;
+
+  StringArena() = default;
+
+  // Copies text into the arena and returns a view that stays valid for the arena's lifetime
+  std::string_view store(std::string_view text);
+
+  std::size_t bytes_used() const { return bytes_used_; }
+
+  // Non-copyable: views handed out point into the owned blocks
+  StringArena(const StringArena &) = delete;
+  StringArena &operator=(const StringArena &) = delete;
+  StringArena(StringArena &&) = default;
+  StringArena &operator=(StringArena &&) = default;
+
+private:
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char *cursor_ = nullptr;
+  std::size_t remaining_ = 0;
+  std::size_t bytes_used_ = 0;
+};
+
+/**
+ * Deduplicating string table shared by every thread: equal strings intern to the same
+ * arena-backed view, so memory grows with the unique strings, not with the threads using them.
+ * Looking up a string already interned takes no lock (insert-only chained buckets, published
+ * with release stores); only inserting takes the mutex. Outgrown bucket arrays are kept until
+ * destruction, since a reader may still be walking one; together they stay under twice the
+ * final size.
+ */
+class StringInterner
+{
+public:
+  StringInterner();
+
+  // Thread-safe; the view stays valid for the interner's lifetime
+  std::string_view intern(std::string_view text);
+
+  std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+  std::size_t bytes_used() const;
+
+  StringInterner(const StringInterner &) = delete;
+  StringInterner &operator=(const StringInterner &) = delete;
+
+private:
+  // Immutable once reachable from a bucket
+  struct Node
+  {
+    std::string_view text_;
+    std::size_t hash_;
+    const Node *next_;
+  };
+
+  struct Table
+  {
+    explicit Table(std::size_t bucket_count);
+
+    std::size_t mask_;
+    std::unique_ptr<std::atomic<const Node *>[]> buckets_;
+    std::deque<Node> nodes_; // stable addresses as it grows
+  };
+
+  static const Node *find(const Table &table, std::string_view text, std::size_t hash);
+  static void insert(Table &table, std::string_view text, std::size_t hash);
+
+  static constexpr std::size_t initial_buckets = 256;
+
+  std::atomic<const Table *> table_; // the newest of tables_, read without the mutex
+  std::atomic<std::size_t> size_{0};
+  mutable std::mutex mutex_;         // guards tables_ and arena_
+  std::vector<std::unique_ptr<Table>> tables_;
+  StringArena arena_;
+};
+
+} // namespace utils
+} // namespace tUnit
@@ -3,12 +3,16 @@
  */
 #pragma once
 
+#include "utils/allocation_tracker.h"
+#include "utils/spin_lock.h"
 #include <cstdint>
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace tUnit
@@ -27,7 +31,7 @@ struct TraceInfo
   std::int32_t line_;
   std::string msg_;
 
-  TraceInfo(const std::string &file, std::int32_t line, const std::string &msg) : file_(file), line_(line), msg_(msg) {}
+  TraceInfo(std::string_view file, std::int32_t line, std::string_view msg) : file_(file), line_(line), msg_(msg) {}
 
   std::string to_string() const
   {
@@ -90,85 +94,118 @@ private:
   }
 };
 
+/**
+ * One thread's trace points; locked so another thread (the timeout watchdog) can read it
+ *
+ * Popped entries are kept and overwritten by the next push, so once a thread has reached its
+ * usual depth, tracing (e.g. every predicate call) reuses their strings instead of allocating.
+ */
+struct TraceStack
+{
+  mutable utils::SpinLock lock_;
+  std::vector<TraceInfo> points_;
+  std::size_t depth_ = 0; // points_[0, depth_) are live
+};
+
 class TraceContext
 {
 public:
-  static void push_trace(const std::string &file, std::int32_t line, const std::string &message)
+  // The trace stack outlives any one test, so its memory is not charged to the running test
+  // Returns the depth of the new entry
+  static std::size_t push_trace(std::string_view file, std::int32_t line, std::string_view message)
   {
-    current_trace_.emplace_back(file, line, message);
+    utils::AllocationPause pause;
+    TraceStack &stack = current_trace_;
+    std::lock_guard<utils::SpinLock> guard(stack.lock_);
+    if (stack.depth_ == stack.points_.size())
+    {
+      stack.points_.emplace_back(file, line, message);
+    }
+    else
+    {
+      TraceInfo &point = stack.points_[stack.depth_];
+      point.file_.assign(file.data(), file.size());
+      point.line_ = line;
+      point.msg_.assign(message.data(), message.size());
+    }
+    return stack.depth_++;
   }
 
   static void pop_trace()
   {
-    if (!current_trace_.empty())
+    std::lock_guard<utils::SpinLock> guard(current_trace_.lock_);
+    if (current_trace_.depth_ > 0)
     {
-      current_trace_.pop_back();
+      --current_trace_.depth_;
     }
   }
 
-  static std::vector<TraceInfo> get_current_trace() { return current_trace_; }
+  // An entry of the calling thread's stack, valid while it is live
+  static const TraceInfo &trace_at(std::size_t depth) { return current_trace_.points_[depth]; }
+
+  static std::vector<TraceInfo> get_current_trace()
+  {
+    const TraceStack &stack = current_trace_;
+    return std::vector<TraceInfo>(stack.points_.begin(), stack.points_.begin() + stack.depth_);
+  }
 
   static void enrich_exception(TracedException &ex)
   {
-    for (const auto &trace_point : current_trace_)
+    for (std::size_t i = 0; i < current_trace_.depth_; ++i)
     {
-      ex.add_trace(trace_point);
+      ex.add_trace(current_trace_.points_[i]);
     }
   }
-  static std::string get_trace_output()
+  static std::string get_trace_output() { return get_trace_output(current_trace_); }
+
+  // Another thread's trace, e.g. one stuck in a test; the stack must belong to a live thread
+  static std::string get_trace_output(const TraceStack &stack)
   {
-    if (current_trace_.empty())
+    std::lock_guard<utils::SpinLock> guard(stack.lock_);
+    if (stack.depth_ == 0)
     {
       return "";
     }
 
     std::ostringstream oss;
     oss << "TUnit trace:\n";
-    for (auto it = current_trace_.rbegin(); it != current_trace_.rend(); ++it)
+    for (std::size_t i = stack.depth_; i-- > 0;)
     {
-      oss << it->to_string() << "\n";
+      oss << stack.points_[i].to_string() << "\n";
     }
     return oss.str();
   }
 
+  // The calling thread's stack, valid until the thread exits
+  static const TraceStack &this_thread() { return current_trace_; }
+
 private:
-  static thread_local std::vector<TraceInfo> current_trace_;
+  static thread_local TraceStack current_trace_;
 };
 
+/**
+ * Pushes a trace point for the lifetime of the scope; the point itself lives in the thread's TraceStack
+ */
 class ScopedTrace
 {
 private:
-  std::string file_;
-  std::int32_t line_;
-  std::string message_;
+  std::size_t depth_;
 
 public:
-  ScopedTrace(const std::string &file, std::int32_t line, const std::string &message) : file_(file), line_(line), message_(message)
+  ScopedTrace(std::string_view file, std::int32_t line, std::string_view message)
+      : depth_(TraceContext::push_trace(file, line, message)) // RAII
   {
-    TraceContext::push_trace(file_, line_, message_); // RAII
   }
 
   ~ScopedTrace() { TraceContext::pop_trace(); }
 
-  const std::string &file() const { return file_; }
-  std::int32_t line() const { return line_; }
-  const std::string &message() const { return message_; }
+  const std::string &file() const { return TraceContext::trace_at(depth_).file_; }
+  std::int32_t line() const { return TraceContext::trace_at(depth_).line_; }
+  const std::string &message() const { return TraceContext::trace_at(depth_).msg_; }
 
-  std::string to_string() const
-  {
-    std::ostringstream oss;
-    if (!file_.empty())
-    {
-      oss << file_ << ":" << line_ << ": " << message_;
-    }
-    else
-    {
-      oss << message_;
-    }
-    return oss.str();
-  }
+  std::string to_string() const { return TraceContext::trace_at(depth_).to_string(); }
 
-  TraceInfo to_trace_info() const { return TraceInfo(file_, line_, message_); }
+  TraceInfo to_trace_info() const { return TraceContext::trace_at(depth_); }
 
   // Non-copyable/movable
   ScopedTrace(const ScopedTrace &) = delete;
@@ -0,0 +1,65 @@
+/**
+ * One background thread that fires deadlines, kept in a timer heap
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace tUnit
+{
+namespace utils
+{
+
+/**
+ * Cancelled timers stay in the heap until they reach the top and are dropped there, so arm
+ * and cancel are O(log n) and O(1) and the thread sleeps until the earliest live deadline
+ */
+class Watchdog
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  Watchdog();
+  ~Watchdog();
+
+  Watchdog(const Watchdog &) = delete;
+  Watchdog &operator=(const Watchdog &) = delete;
+
+  // on_expiry runs on the watchdog thread at deadline unless cancel(id) comes first
+  std::uint64_t arm(Clock::time_point deadline, std::function<void()> on_expiry);
+  // Waits for the timer's callback if it has already started, so whatever the callback
+  // references may be destroyed once cancel returns
+  void cancel(std::uint64_t id);
+
+private:
+  struct Timer
+  {
+    Clock::time_point deadline_;
+    std::uint64_t id_;
+
+    bool operator>(const Timer &other) const { return deadline_ > other.deadline_; }
+  };
+
+  void loop();
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable callback_done_;
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> heap_;
+  std::unordered_map<std::uint64_t, std::function<void()>> pending_;
+  std::uint64_t next_id_ = 1;
+  std::uint64_t running_ = 0; // id of the callback in progress, 0 = none
+  bool stopping_ = false;
+  std::thread thread_; // last, so it starts after everything it uses
+};
+
+} // namespace utils
+} // namespace tUnit
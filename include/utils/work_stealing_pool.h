@@ -0,0 +1,47 @@
+/**
+ * Fixed-size worker pool that balances a batch of independent tasks by work stealing
+ */
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace tUnit
+{
+namespace utils
+{
+
+/**
+ * Each worker owns a deque seeded with a contiguous block of task indices. Owners pop from
+ * the front (preserving submission order locally); idle workers steal from the back of a victim.
+ */
+class WorkStealingPool
+{
+public:
+  explicit WorkStealingPool(std::size_t workers);
+
+  // Runs task(index) for every index in [0, count) and returns once all have finished
+  void run(std::size_t count, const std::function<void(std::size_t worker, std::size_t index)> &task);
+
+  std::size_t workers() const { return queues_.size(); }
+
+private:
+  struct WorkQueue
+  {
+    std::mutex mutex_;
+    std::deque<std::size_t> tasks_;
+  };
+
+  std::optional<std::size_t> pop(std::size_t worker);
+  std::optional<std::size_t> steal(std::size_t thief);
+
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+};
+
+} // namespace utils
+} // namespace tUnit
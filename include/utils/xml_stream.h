@@ -0,0 +1,66 @@
+/**
+ * Buffered output stream for XML reports: one large buffer, flushed when full, with
+ * table-driven escaping of text and attribute values
+ */
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tUnit
+{
+namespace utils
+{
+
+class XmlStream
+{
+public:
+  static constexpr size_t default_buffer_size = 1 << 20;
+
+  explicit XmlStream(const std::string &path, size_t buffer_size = default_buffer_size);
+  ~XmlStream();
+
+  XmlStream(const XmlStream &) = delete;
+  XmlStream &operator=(const XmlStream &) = delete;
+
+  bool is_open() const { return file_ != nullptr; }
+
+  // Markup, written as-is
+  XmlStream &raw(std::string_view text);
+  // Character data: markup characters become entities and characters XML 1.0 cannot
+  // represent become U+FFFD
+  XmlStream &escaped(std::string_view text);
+  // An attribute value: as escaped(), and tabs and line breaks become character references
+  XmlStream &attribute(std::string_view text);
+  XmlStream &number(std::uint64_t value);
+  // Seconds with microsecond precision, as JUnit time attributes expect
+  XmlStream &seconds(std::chrono::nanoseconds duration);
+  XmlStream &decimal(double value);
+
+  // Appends the escaped form of text to out, as escaped() or attribute() would write it
+  static void escape_to(std::string &out, std::string_view text, bool attribute = false);
+
+  // Writes buffered output; false if any write so far has failed
+  bool flush();
+  // As flush(), then writes closing and moves back before it, so the next write replaces it:
+  // the file on disk stays a complete document however the process ends
+  bool checkpoint(std::string_view closing);
+  bool close();
+
+private:
+  XmlStream &escaped(std::string_view text, const std::array<const char *, 256> &table);
+  void put(const char *data, size_t size);
+
+  std::FILE *file_ = nullptr;
+  std::vector<char> buffer_;
+  size_t used_ = 0;
+  bool failed_ = false;
+};
+
+} // namespace utils
+} // namespace tUnit
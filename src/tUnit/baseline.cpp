@@ -0,0 +1,113 @@
+#include "tUnit/result_format.h"
+#include "tUnit/test_case.h"
+#include "tUnit/test_orchestrator.h"
+#include "tUnit/test_suite.h"
+#include "utils/mapped_file.h"
+#include "utils/statistics.h"
+#include <cstdio>
+#include <iostream>
+
+namespace tUnit
+{
+
+namespace
+{
+
+std::string baseline_key(std::string_view suite, std::string_view test, std::string_view benchmark)
+{
+  std::string key;
+  key.reserve(suite.size() + test.size() + benchmark.size() + 4);
+  key.append(suite).append("::").append(test).append("::").append(benchmark);
+  return key;
+}
+
+} // anonymous namespace
+
+// Baselines are ordinary binary results files; only the benchmark samples are used
+bool Orchestrator::load_baseline(const std::string &path)
+{
+  utils::MappedFile file(path);
+  std::string error = "could not open file";
+  bool ok = file.is_open() && result_format::read(
+                                  file.bytes(), [this](const result_format::TestRecord &record)
+                                  {
+    for (const BenchmarkResult &benchmark : record.benchmarks_)
+    {
+      baseline_[baseline_key(record.suite_, record.test_, benchmark.name_)] = benchmark;
+    } },
+                                  &error);
+  if (!ok)
+  {
+    std::cerr << "Error: Could not load baseline " << path << ": " << error << std::endl;
+  }
+  return ok;
+}
+
+void Orchestrator::save_baseline() const
+{
+  result_format::Writer writer;
+  {
+    std::lock_guard<std::mutex> guard(registry_mutex_);
+    for (const Suite *suite : suite_order_)
+    {
+      for (const Test *test : suite->test_order_)
+      {
+        if (!test->results_->benchmarks_.empty())
+        {
+          result_format::TestRecord record;
+          record.suite_ = test->suite_name();
+          record.test_ = test->name();
+          record.benchmarks_ = test->results_->benchmarks_;
+          writer.add_test(record);
+        }
+      }
+    }
+  }
+
+  std::FILE *file = std::fopen(save_baseline_path_.c_str(), "wb");
+  if (file == nullptr || std::fwrite(writer.bytes().data(), 1, writer.bytes().size(), file) != writer.bytes().size())
+  {
+    std::cerr << "Error: Could not write baseline file: " << save_baseline_path_ << std::endl;
+  }
+  if (file != nullptr)
+  {
+    std::fclose(file);
+  }
+}
+
+void Orchestrator::compare_to_baseline(TestResults &results, const BenchmarkResult &benchmark)
+{
+  const Test &test = *results.test_;
+  auto it = baseline_.find(baseline_key(test.suite_name(), test.name(), benchmark.name_));
+  if (it == baseline_.end())
+  {
+    return; // new benchmark: nothing to regress against
+  }
+
+  const BenchmarkResult &base = it->second;
+  const double before = utils::median(base.samples_ns_);
+  const double change = before > 0 ? benchmark.median_ns_ / before - 1.0 : 0.0;
+  const double p = utils::mann_whitney_greater_p(base.samples_ns_, benchmark.samples_ns_);
+  const bool regressed = change > regression_threshold_ && p < regression_alpha_;
+
+  char description[256];
+  std::snprintf(description, sizeof(description), "benchmark %s %s baseline: median %.4g ns vs %.4g ns (%+.1f%%, p=%.3g)",
+                benchmark.name_.c_str(), regressed ? "regressed against" : "within", benchmark.median_ns_, before, change * 100, p);
+  log_assertion(results, description, !regressed);
+
+  // Retired instructions barely move between runs of the same binary, so they are compared
+  // directly, without a significance test; this is the gate that still works on noisy CI machines
+  constexpr auto instructions = utils::PerfCounts::instructions;
+  if (base.counters_.has(instructions) && benchmark.counters_.has(instructions) && base.measured_iterations() > 0)
+  {
+    const double old_count = static_cast<double>(base.counters_[instructions]) / base.measured_iterations();
+    const double new_count = static_cast<double>(benchmark.counters_[instructions]) / benchmark.measured_iterations();
+    const double growth = old_count > 0 ? new_count / old_count - 1.0 : 0.0;
+    const bool more = growth > regression_threshold_;
+    std::snprintf(description, sizeof(description), "benchmark %s instructions %s baseline: %.4g vs %.4g per iteration (%+.1f%%)",
+                  benchmark.name_.c_str(), more ? "regressed against" : "within", new_count, old_count, growth * 100);
+    log_assertion(results, description, !more);
+  }
+}
+
+} // namespace tUnit
@@ -0,0 +1,36 @@
+#include "tUnit/benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace tUnit
+{
+namespace detail
+{
+
+void summarize(BenchmarkResult &result)
+{
+  const std::vector<double> &samples = result.samples_ns_;
+  if (samples.empty())
+  {
+    return;
+  }
+
+  std::vector<double> sorted = samples;
+  std::sort(sorted.begin(), sorted.end());
+  const size_t n = sorted.size();
+  result.min_ns_ = sorted.front();
+  result.median_ns_ = n % 2 == 1 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+  result.mean_ns_ = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(n);
+
+  // Sample standard deviation
+  double squares = 0;
+  for (double sample : sorted)
+  {
+    squares += (sample - result.mean_ns_) * (sample - result.mean_ns_);
+  }
+  result.stddev_ns_ = n > 1 ? std::sqrt(squares / static_cast<double>(n - 1)) : 0;
+}
+
+} // namespace detail
+} // namespace tUnit
@@ -0,0 +1,499 @@
+#include "tUnit/test_case.h"
+#include "tUnit/test_orchestrator.h"
+#include "tUnit/test_registry.h"
+#include "tUnit/test_results.h"
+#include "utils/byte_stream.h"
+#include "utils/trace_support.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace tUnit
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+// Fresh workers that may die before accepting a test; past this the test fails instead
+constexpr int max_respawns = 3;
+
+/**
+ * One pre-forked worker process and the test it is currently running
+ */
+struct WorkerProcess
+{
+  pid_t pid_ = -1;
+  int command_fd_ = -1; // parent -> worker: u32 test index
+  int result_fd_ = -1;  // worker -> parent: u64 length + results payload
+  size_t test_ = SIZE_MAX;
+  Clock::time_point started_;
+  double timeout_ = 0;          // seconds, 0 = none
+  Clock::time_point deadline_; // the worker's own watchdog fires first; this catches a wedged one
+
+  bool busy() const { return test_ != SIZE_MAX; }
+};
+
+bool write_all(int fd, const char *data, size_t size)
+{
+  while (size > 0)
+  {
+    ssize_t written = ::write(fd, data, size);
+    if (written < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (written <= 0)
+    {
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+bool read_all(int fd, char *data, size_t size)
+{
+  while (size > 0)
+  {
+    ssize_t got = ::read(fd, data, size);
+    if (got < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (got <= 0)
+    {
+      return false;
+    }
+    data += got;
+    size -= static_cast<size_t>(got);
+  }
+  return true;
+}
+
+// Frames a payload with its u64 length so the reader knows when a message is complete
+bool send_message(int fd, const std::string &payload)
+{
+  utils::ByteWriter header;
+  header.u64(payload.size());
+  return write_all(fd, header.bytes().data(), header.bytes().size()) && write_all(fd, payload.data(), payload.size());
+}
+
+bool receive_message(int fd, std::string &payload)
+{
+  char header[8];
+  std::uint64_t size = 0;
+  if (!read_all(fd, header, sizeof(header)) || !utils::ByteReader(std::string_view(header, sizeof(header))).u64(size))
+  {
+    return false;
+  }
+  payload.resize(size);
+  return read_all(fd, payload.data(), size);
+}
+
+void close_fd(int &fd)
+{
+  if (fd >= 0)
+  {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+std::string describe_exit(int status)
+{
+  if (WIFSIGNALED(status))
+  {
+    int signal = WTERMSIG(status);
+    const char *name = ::strsignal(signal);
+    return "test process crashed: signal " + std::to_string(signal) + (name ? std::string(" (") + name + ")" : "");
+  }
+  if (WIFEXITED(status))
+  {
+    return "test process exited with status " + std::to_string(WEXITSTATUS(status));
+  }
+  return "test process ended unexpectedly";
+}
+
+} // anonymous namespace
+
+void Orchestrator::run_isolated(const std::vector<size_t> &selected, const std::vector<Test *> &tests, size_t worker_count)
+{
+  TUNIT_SCOPED_TRACE("running " + std::to_string(tests.size()) + " tests in " + std::to_string(worker_count) + " worker processes");
+
+  std::vector<WorkerProcess> workers(worker_count);
+
+  // Worker side: run tests on request and send back every result they produced, including
+  // assertions logged against tests other than the one being run
+  auto serve = [this, &selected, &tests](int command_fd, int result_fd)
+  {
+    // Reporters belong to the parent, which replays these results into them
+    has_listeners_.store(false, std::memory_order_relaxed);
+    has_assertion_listeners_.store(false, std::memory_order_relaxed);
+    worker_process_ = true;
+    std::optional<utils::Watchdog> watchdog;
+    if (has_timeouts(selected))
+    {
+      watchdog_ = &watchdog.emplace();
+    }
+    if (memory_limit_mb_ > 0)
+    {
+      rlimit limit{};
+      limit.rlim_cur = limit.rlim_max = static_cast<rlim_t>(memory_limit_mb_) * 1024 * 1024;
+      ::setrlimit(RLIMIT_AS, &limit);
+    }
+
+    // Results inherited from the parent are the baseline, taken once; only what a test adds is
+    // sent, and only the tests it changed are looked at, so a message costs O(changed tests)
+    // rather than O(registered tests)
+    struct Sent
+    {
+      size_t total_ = 0;
+      size_t stored_ = 0; // assertions_.size()
+      size_t benchmarks_ = 0;
+    };
+    std::vector<Sent> sent; // indexed by TestResults::slot_
+    std::vector<size_t> changed;
+    auto snapshot = [this, &sent](size_t slot)
+    {
+      const TestResults &results = *results_by_slot_[slot];
+      sent[slot] = {results.total_, results.assertions_.size(), results.benchmarks_.size()};
+    };
+    {
+      std::lock_guard<std::mutex> guard(registry_mutex_);
+      take_collected_slots_locked(changed);
+      sent.resize(results_by_slot_.size());
+      for (size_t slot = 0; slot < sent.size(); ++slot)
+      {
+        snapshot(slot);
+      }
+    }
+
+    utils::ByteWriter payload;
+    char command[4];
+    std::uint32_t index = 0;
+    while (read_all(command_fd, command, sizeof(command)) && utils::ByteReader(std::string_view(command, sizeof(command))).u32(index))
+    {
+      Test &test = *tests[index];
+      run_test(registrations_[selected[index]], test);
+
+      std::lock_guard<std::mutex> guard(registry_mutex_);
+      take_collected_slots_locked(changed);
+      sent.resize(results_by_slot_.size()); // tests created by this one start from nothing
+
+      payload.clear();
+      payload.u64(static_cast<std::uint64_t>(test.timing_.wall_.count()));
+      payload.u64(static_cast<std::uint64_t>(test.timing_.user_.count()));
+      payload.u64(static_cast<std::uint64_t>(test.timing_.system_.count()));
+      utils::put_counts(payload, test.timing_.counters_);
+      utils::put_allocations(payload, test.timing_.allocations_);
+      payload.u32(static_cast<std::uint32_t>(changed.size()));
+      for (size_t slot : changed)
+      {
+        const TestResults &results = *results_by_slot_[slot];
+        const Test *other = results.test_;
+        const Sent &before = sent[slot];
+        const size_t stored = results.assertions_.size() - before.stored_;
+        payload.str(other->suite_name());
+        payload.str(other->name());
+        payload.u64(results.total_ - before.total_ - stored); // passes not retained
+        payload.u32(static_cast<std::uint32_t>(stored));
+        for (size_t i = before.stored_; i < results.assertions_.size(); ++i)
+        {
+          payload.u8(results.assertions_[i].result_ ? 1 : 0);
+          payload.str(results.assertions_[i].description_);
+        }
+        payload.u32(static_cast<std::uint32_t>(results.benchmarks_.size() - before.benchmarks_));
+        for (size_t i = before.benchmarks_; i < results.benchmarks_.size(); ++i)
+        {
+          const BenchmarkResult &benchmark = results.benchmarks_[i];
+          payload.str(benchmark.name_);
+          payload.u64(benchmark.iterations_);
+          payload.u32(static_cast<std::uint32_t>(benchmark.samples_ns_.size()));
+          for (double sample : benchmark.samples_ns_)
+          {
+            payload.f64(sample);
+          }
+          utils::put_counts(payload, benchmark.counters_);
+        }
+        snapshot(slot);
+      }
+
+      std::fflush(nullptr);
+      if (!send_message(result_fd, payload.bytes()))
+      {
+        break;
+      }
+    }
+  };
+
+  // Forked from the fully initialized runner, so workers skip static initialization entirely
+  auto spawn = [&workers, &serve](WorkerProcess &worker)
+  {
+    int command_pipe[2];
+    int result_pipe[2];
+    if (::pipe(command_pipe) != 0 || ::pipe(result_pipe) != 0)
+    {
+      tUnit::trace::throw_traced(std::string("Could not create worker pipes: ") + std::strerror(errno));
+    }
+
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    pid_t pid = ::fork();
+    if (pid < 0)
+    {
+      tUnit::trace::throw_traced(std::string("Could not fork test worker: ") + std::strerror(errno));
+    }
+
+    if (pid == 0)
+    {
+      // A worker holding another worker's pipe ends would hide that worker's exit
+      for (auto &other : workers)
+      {
+        close_fd(other.command_fd_);
+        close_fd(other.result_fd_);
+      }
+      ::close(command_pipe[1]);
+      ::close(result_pipe[0]);
+      serve(command_pipe[0], result_pipe[1]);
+      std::cout.flush();
+      std::fflush(nullptr);
+      ::_exit(0); // no static destructors or atexit handlers from the parent's state
+    }
+
+    ::close(command_pipe[0]);
+    ::close(result_pipe[1]);
+    worker.pid_ = pid;
+    worker.command_fd_ = command_pipe[1];
+    worker.result_fd_ = result_pipe[0];
+    worker.test_ = SIZE_MAX;
+  };
+
+  // Reaps a dead or hung worker, fails the test it was running and starts a replacement
+  auto replace = [this, &tests, &spawn](WorkerProcess &worker, std::string reason, bool kill)
+  {
+    if (kill)
+    {
+      ::kill(worker.pid_, SIGKILL);
+    }
+    int status = 0;
+    ::waitpid(worker.pid_, &status, 0);
+    close_fd(worker.command_fd_);
+    close_fd(worker.result_fd_);
+
+    if (worker.busy())
+    {
+      if (reason.empty() && WIFEXITED(status) && WEXITSTATUS(status) == exit_timed_out && worker.timeout_ > 0)
+      {
+        std::ostringstream timed_out;
+        timed_out << "test timed out after " << worker.timeout_ << "s";
+        reason = timed_out.str();
+      }
+      Test &test = *tests[worker.test_];
+      test.timing_ = TestTiming{};
+      test.timing_.wall_ = Clock::now() - worker.started_;
+      log_assertion(*test.results_, reason.empty() ? describe_exit(status) : reason, false);
+      if (has_listeners_.load(std::memory_order_relaxed))
+      {
+        notify_test_finished(test);
+      }
+    }
+    spawn(worker);
+  };
+
+  // Replays one worker message into this process's results
+  auto apply = [this, &tests](WorkerProcess &worker, const std::string &message)
+  {
+    utils::ByteReader reader(message);
+    std::uint64_t wall_ns = 0, user_ns = 0, system_ns = 0;
+    std::uint32_t changed = 0;
+    reader.u64(wall_ns);
+    reader.u64(user_ns);
+    reader.u64(system_ns);
+    utils::PerfCounts counters;
+    utils::get_counts(reader, counters);
+    utils::AllocationStats allocations;
+    utils::get_allocations(reader, allocations);
+    reader.u32(changed);
+    tests[worker.test_]->timing_ = TestTiming{std::chrono::nanoseconds(wall_ns), std::chrono::nanoseconds(user_ns), std::chrono::nanoseconds(system_ns), counters, allocations};
+
+    for (std::uint32_t c = 0; c < changed; ++c)
+    {
+      std::string_view suite_name, test_name;
+      std::uint64_t passes = 0;
+      std::uint32_t stored = 0;
+      if (!reader.str(suite_name) || !reader.str(test_name) || !reader.u64(passes) || !reader.u32(stored))
+      {
+        break;
+      }
+      TestResults &results = *get_test(suite_name, test_name).results_;
+      for (std::uint32_t i = 0; i < stored; ++i)
+      {
+        std::uint8_t passed = 0;
+        std::string_view description;
+        if (!reader.u8(passed) || !reader.str(description))
+        {
+          break;
+        }
+        log_assertion(results, description, passed != 0);
+      }
+      log_passed(results, passes);
+
+      std::uint32_t benchmarks = 0;
+      reader.u32(benchmarks);
+      for (std::uint32_t b = 0; b < benchmarks; ++b)
+      {
+        BenchmarkResult benchmark;
+        std::string_view name;
+        std::uint32_t samples = 0;
+        if (!reader.str(name) || !reader.u64(benchmark.iterations_) || !reader.u32(samples))
+        {
+          break;
+        }
+        benchmark.name_ = name;
+        benchmark.samples_ns_.resize(samples);
+        for (double &sample : benchmark.samples_ns_)
+        {
+          reader.f64(sample);
+        }
+        utils::get_counts(reader, benchmark.counters_);
+        detail::summarize(benchmark);
+        store_benchmark(results, benchmark); // compared in the worker
+      }
+    }
+    if (has_listeners_.load(std::memory_order_relaxed))
+    {
+      notify_test_finished(*tests[worker.test_]);
+    }
+    worker.test_ = SIZE_MAX;
+  };
+
+  // Writing to a worker that just died must fail with EPIPE instead of killing the runner
+  auto previous_sigpipe = std::signal(SIGPIPE, SIG_IGN);
+
+  for (auto &worker : workers)
+  {
+    spawn(worker);
+  }
+
+  size_t next = 0;
+  size_t finished = 0;
+  std::string message;
+  std::vector<pollfd> fds;
+  std::vector<WorkerProcess *> polled;
+  while (finished < tests.size())
+  {
+    for (auto &worker : workers)
+    {
+      if (worker.busy() || next >= tests.size())
+      {
+        continue;
+      }
+      utils::ByteWriter command;
+      command.u32(static_cast<std::uint32_t>(next));
+      int respawns = 0;
+      bool accepted = false;
+      while (!(accepted = write_all(worker.command_fd_, command.bytes().data(), command.bytes().size())) && respawns++ < max_respawns)
+      {
+        // Died between tests: nothing to report, just replace it
+        replace(worker, {}, false);
+      }
+      if (!accepted)
+      {
+        // Workers die on startup (e.g. --memory-limit below what the runner needs): fail the
+        // test instead of forking forever; the next test tries the worker again
+        Test &test = *tests[next++];
+        ++finished;
+        log_assertion(*test.results_, "test process could not be started (" + std::to_string(max_respawns) + " workers died before accepting it)", false);
+        if (has_listeners_.load(std::memory_order_relaxed))
+        {
+          notify_test_started(test);
+          notify_test_finished(test);
+        }
+        continue;
+      }
+      worker.test_ = next++;
+      worker.started_ = Clock::now();
+      worker.timeout_ = timeout_for(registrations_[selected[worker.test_]]);
+      const auto grace = std::chrono::duration<double>(worker.timeout_ * 0.1 + 1.0); // time to print the trace
+      worker.deadline_ = worker.timeout_ > 0 ? worker.started_ + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(worker.timeout_) + grace)
+                                             : Clock::time_point::max();
+      if (has_listeners_.load(std::memory_order_relaxed))
+      {
+        notify_test_started(*tests[worker.test_]);
+      }
+    }
+
+    fds.clear();
+    polled.clear();
+    int wait_ms = -1;
+    for (auto &worker : workers)
+    {
+      if (!worker.busy())
+      {
+        continue;
+      }
+      fds.push_back({worker.result_fd_, POLLIN, 0});
+      polled.push_back(&worker);
+      if (worker.deadline_ != Clock::time_point::max())
+      {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(worker.deadline_ - Clock::now()).count() + 1;
+        wait_ms = wait_ms < 0 ? static_cast<int>(std::max<long long>(0, left)) : std::min(wait_ms, static_cast<int>(std::max<long long>(0, left)));
+      }
+    }
+
+    if (::poll(fds.data(), fds.size(), wait_ms) < 0 && errno != EINTR)
+    {
+      tUnit::trace::throw_traced(std::string("Waiting for test workers failed: ") + std::strerror(errno));
+    }
+
+    for (size_t i = 0; i < fds.size(); ++i)
+    {
+      WorkerProcess &worker = *polled[i];
+      if (fds[i].revents != 0)
+      {
+        ++finished;
+        if (receive_message(worker.result_fd_, message))
+        {
+          apply(worker, message);
+        }
+        else
+        {
+          replace(worker, {}, false);
+        }
+      }
+      else if (Clock::now() >= worker.deadline_)
+      {
+        ++finished;
+        std::ostringstream reason;
+        reason << "test timed out after " << worker.timeout_ << "s (worker killed)";
+        replace(worker, reason.str(), true);
+      }
+    }
+  }
+
+  // Closing the command pipe is the shutdown signal
+  for (auto &worker : workers)
+  {
+    close_fd(worker.command_fd_);
+    close_fd(worker.result_fd_);
+    ::waitpid(worker.pid_, nullptr, 0);
+  }
+  std::signal(SIGPIPE, previous_sigpipe);
+}
+
+} // namespace tUnit
@@ -0,0 +1,348 @@
+#include "tUnit/reporters.h"
+#include "tUnit/test_case.h"
+#include "tUnit/test_orchestrator.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace tUnit
+{
+
+namespace
+{
+
+void json_escape_to(std::string &out, std::string_view text)
+{
+  for (char c : text)
+  {
+    switch (c)
+    {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+        out += escaped;
+      }
+      else
+      {
+        out += c;
+      }
+    }
+  }
+}
+
+std::string json_string(std::string_view text)
+{
+  std::string out = "\"";
+  json_escape_to(out, text);
+  out += '"';
+  return out;
+}
+
+// {"cycles":...,...} with only the available events
+std::string json_counts(const utils::PerfCounts &counts, double per = 1)
+{
+  std::string out = "{";
+  char value[32];
+  for (int event = 0; event < utils::PerfCounts::event_count; ++event)
+  {
+    if (counts.has(static_cast<utils::PerfCounts::Event>(event)))
+    {
+      std::snprintf(value, sizeof(value), "%.9g", static_cast<double>(counts.values_[event]) / per);
+      out.append(out.size() == 1 ? "\"" : ",\"").append(utils::PerfCounts::names[event]).append("\":").append(value);
+    }
+  }
+  return out + "}";
+}
+
+void write_count_properties(utils::XmlStream &xml, std::string_view prefix, std::string_view name, const utils::PerfCounts &counts, double per)
+{
+  for (int event = 0; event < utils::PerfCounts::event_count; ++event)
+  {
+    if (counts.has(static_cast<utils::PerfCounts::Event>(event)))
+    {
+      xml.raw("        <property name=\"").raw(prefix).attribute(name).raw(utils::PerfCounts::names[event]);
+      xml.raw("\" value=\"").decimal(static_cast<double>(counts.values_[event]) / per).raw("\"/>\n");
+    }
+  }
+}
+
+// Kept after the last testcase of JUnitReporter's streamed file
+constexpr std::string_view partial_closing = "  </testsuite>\n</testsuites>\n";
+
+} // anonymous namespace
+
+void write_junit_testcase(utils::XmlStream &xml, const TestOutcome &outcome)
+{
+  const Test &test = outcome.test_;
+  xml.raw("    <testcase name=\"").attribute(test.name());
+  xml.raw("\" classname=\"").attribute(test.suite_name());
+  xml.raw("\" assertions=\"").number(outcome.assertions_);
+  xml.raw("\" time=\"").seconds(outcome.timing_.wall_).raw("\">\n");
+
+  // Benchmarks and counters as properties, which JUnit consumers accept on a testcase
+  const utils::AllocationStats &heap = outcome.timing_.allocations_;
+  if (!outcome.benchmarks_.empty() || outcome.timing_.counters_.any() || heap.tracked_)
+  {
+    xml.raw("      <properties>\n");
+    write_count_properties(xml, "perf.", "", outcome.timing_.counters_, 1);
+    if (heap.tracked_)
+    {
+      const std::pair<const char *, std::uint64_t> stats[] = {
+          {"allocations", heap.allocations_}, {"bytes", heap.bytes_},
+          {"peak_bytes", static_cast<std::uint64_t>(heap.peak_live_bytes_)}, {"leaked_bytes", heap.leaked_bytes()}};
+      for (const auto &[stat, value] : stats)
+      {
+        xml.raw("        <property name=\"heap.").raw(stat).raw("\" value=\"").number(value).raw("\"/>\n");
+      }
+    }
+    for (const BenchmarkResult &benchmark : outcome.benchmarks_)
+    {
+      const std::pair<const char *, double> stats[] = {
+          {"iterations", static_cast<double>(benchmark.iterations_)}, {"samples", static_cast<double>(benchmark.samples_ns_.size())},
+          {"min_ns", benchmark.min_ns_}, {"median_ns", benchmark.median_ns_}, {"mean_ns", benchmark.mean_ns_},
+          {"stddev_ns", benchmark.stddev_ns_}, {"ops_per_sec", benchmark.ops_per_second()}};
+      for (const auto &[stat, value] : stats)
+      {
+        xml.raw("        <property name=\"benchmark.").attribute(benchmark.name_).raw(".").raw(stat);
+        xml.raw("\" value=\"").decimal(value).raw("\"/>\n");
+      }
+      write_count_properties(xml, "benchmark.", benchmark.name_ + ".perf_per_iter.", benchmark.counters_, benchmark.measured_iterations());
+    }
+    xml.raw("      </properties>\n");
+  }
+
+  for (std::string_view failure : outcome.failures_)
+  {
+    xml.raw("      <failure message=\"").attribute(failure).raw("\">\n        ");
+    xml.escaped(failure).raw("\n      </failure>\n");
+  }
+  xml.raw("    </testcase>\n");
+}
+
+StreamReporter::StreamReporter(const std::string &path) : console_(&std::cout)
+{
+  if (!path.empty())
+  {
+    file_.open(path);
+    if (!file_.is_open())
+    {
+      std::cerr << "Error: Could not open report file: " << path << ", reporting to stdout" << std::endl;
+    }
+  }
+}
+
+void ConsoleReporter::test_finished(const TestOutcome &outcome)
+{
+  const Test &test = outcome.test_;
+  out() << (outcome.passed() ? "[PASS] " : "[FAIL] ") << test.suite_name() << "::" << test.name() << " ("
+        << outcome.assertions_ << " assertions, " << std::chrono::duration<double, std::milli>(outcome.timing_.wall_).count() << " ms)\n";
+  if (outcome.timing_.counters_.any())
+  {
+    out() << "       " << utils::format_counts(outcome.timing_.counters_) << '\n';
+  }
+  for (std::string_view failure : outcome.failures_)
+  {
+    out() << "       " << failure << '\n';
+  }
+  out().flush();
+}
+
+void JsonLinesReporter::test_finished(const TestOutcome &outcome)
+{
+  std::string line = "{\"event\":\"test_end\",\"suite\":" + json_string(outcome.test_.suite_name()) +
+                     ",\"test\":" + json_string(outcome.test_.name()) +
+                     ",\"passed\":" + (outcome.passed() ? "true" : "false") +
+                     ",\"assertions\":" + std::to_string(outcome.assertions_) +
+                     ",\"failed\":" + std::to_string(outcome.failed_) +
+                     ",\"wall_ns\":" + std::to_string(outcome.timing_.wall_.count()) +
+                     ",\"user_ns\":" + std::to_string(outcome.timing_.user_.count()) +
+                     ",\"system_ns\":" + std::to_string(outcome.timing_.system_.count()) + ",\"failures\":[";
+  for (size_t i = 0; i < outcome.failures_.size(); ++i)
+  {
+    line += (i == 0 ? "" : ",") + json_string(outcome.failures_[i]);
+  }
+  line += "]";
+  if (outcome.timing_.counters_.any())
+  {
+    line += ",\"counters\":" + json_counts(outcome.timing_.counters_);
+  }
+  const utils::AllocationStats &heap = outcome.timing_.allocations_;
+  if (heap.tracked_)
+  {
+    line += ",\"heap\":{\"allocations\":" + std::to_string(heap.allocations_) + ",\"bytes\":" + std::to_string(heap.bytes_) +
+            ",\"peak_bytes\":" + std::to_string(heap.peak_live_bytes_) + ",\"leaked_bytes\":" + std::to_string(heap.leaked_bytes()) + "}";
+  }
+  if (!outcome.benchmarks_.empty())
+  {
+    line += ",\"benchmarks\":[";
+    for (size_t i = 0; i < outcome.benchmarks_.size(); ++i)
+    {
+      const BenchmarkResult &benchmark = outcome.benchmarks_[i];
+      char stats[256];
+      std::snprintf(stats, sizeof(stats),
+                    ",\"iterations\":%llu,\"samples\":%zu,\"min_ns\":%.9g,\"median_ns\":%.9g,\"mean_ns\":%.9g,\"stddev_ns\":%.9g,\"ops_per_sec\":%.9g}",
+                    static_cast<unsigned long long>(benchmark.iterations_), benchmark.samples_ns_.size(), benchmark.min_ns_,
+                    benchmark.median_ns_, benchmark.mean_ns_, benchmark.stddev_ns_, benchmark.ops_per_second());
+      line += (i == 0 ? "{\"name\":" : ",{\"name\":") + json_string(benchmark.name_) + stats;
+      if (benchmark.counters_.any())
+      {
+        line.insert(line.size() - 1, ",\"counters_per_iter\":" + json_counts(benchmark.counters_, benchmark.measured_iterations()));
+      }
+    }
+    line += "]";
+  }
+  line += "}\n";
+  out() << line;
+  out().flush();
+}
+
+void JsonLinesReporter::run_finished(const Orchestrator &orchestrator)
+{
+  const ResultCounters totals = orchestrator.counters();
+  out() << "{\"event\":\"run_end\",\"passed\":" << (totals.failed_assertions_ == 0 ? "true" : "false")
+        << ",\"assertions\":" << totals.assertions_ << ",\"failed_assertions\":" << totals.failed_assertions_
+        << ",\"failed_tests\":" << totals.failed_tests_ << "}\n";
+  out().flush();
+}
+
+TapReporter::TapReporter(const std::string &path) : StreamReporter(path)
+{
+  out() << "TAP version 13\n";
+}
+
+void TapReporter::test_finished(const TestOutcome &outcome)
+{
+  // '#' starts a directive in a TAP description
+  std::string name = outcome.test_.suite_name() + "::" + outcome.test_.name();
+  for (char &c : name)
+  {
+    c = c == '#' ? '_' : c;
+  }
+
+  out() << (outcome.passed() ? "ok " : "not ok ") << ++count_ << " - " << name << '\n';
+  if (outcome.timing_.counters_.any())
+  {
+    out() << "# " << utils::format_counts(outcome.timing_.counters_) << '\n';
+  }
+  // Diagnostics: every line of every failure as a comment
+  for (std::string_view failure : outcome.failures_)
+  {
+    size_t start = 0;
+    do
+    {
+      size_t end = std::min(failure.find('\n', start), failure.size());
+      out() << "# " << failure.substr(start, end - start) << '\n';
+      start = end + 1;
+    } while (start < failure.size());
+  }
+  out().flush();
+}
+
+void TapReporter::run_finished(const Orchestrator &)
+{
+  out() << "1.." << count_ << '\n';
+  out().flush();
+}
+
+void JUnitReporter::test_started(const Test &)
+{
+  if (!partial_)
+  {
+    partial_ = std::make_unique<utils::XmlStream>(path_, 64 * 1024);
+    partial_->raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n  <testsuite name=\"partial\">\n");
+    partial_->checkpoint(partial_closing);
+  }
+}
+
+void JUnitReporter::test_finished(const TestOutcome &outcome)
+{
+  test_started(outcome.test_); // merged results arrive without a start event
+  if (failures_only_ && outcome.passed())
+  {
+    return;
+  }
+
+  write_junit_testcase(*partial_, outcome);
+  partial_->checkpoint(partial_closing); // on disk, and closed, before the next test can crash the process
+}
+
+void JUnitReporter::run_finished(const Orchestrator &orchestrator)
+{
+  partial_.reset();
+  orchestrator.write_junit(path_);
+}
+
+BinaryReporter::BinaryReporter(const std::string &path) : path_(path), file_(std::fopen(path.c_str(), "wb"))
+{
+  if (file_ == nullptr)
+  {
+    std::cerr << "Error: Could not open results file: " << path << std::endl;
+    return;
+  }
+  drain(); // the header, so even an empty run leaves a valid file
+}
+
+BinaryReporter::~BinaryReporter()
+{
+  if (file_ != nullptr)
+  {
+    std::fclose(file_);
+  }
+}
+
+void BinaryReporter::drain()
+{
+  if (file_ != nullptr)
+  {
+    std::fwrite(writer_.bytes().data(), 1, writer_.bytes().size(), file_);
+    std::fflush(file_);
+  }
+  writer_.clear();
+}
+
+void BinaryReporter::test_finished(const TestOutcome &outcome)
+{
+  result_format::TestRecord record;
+  record.suite_ = outcome.test_.suite_name();
+  record.test_ = outcome.test_.name();
+  record.assertions_ = outcome.assertions_;
+  record.failed_ = outcome.failed_;
+  record.wall_ns_ = static_cast<std::uint64_t>(outcome.timing_.wall_.count());
+  record.user_ns_ = static_cast<std::uint64_t>(outcome.timing_.user_.count());
+  record.system_ns_ = static_cast<std::uint64_t>(outcome.timing_.system_.count());
+  record.failures_ = outcome.failures_;
+  record.benchmarks_ = outcome.benchmarks_;
+  record.counters_ = outcome.timing_.counters_;
+  record.allocations_ = outcome.timing_.allocations_;
+  writer_.add_test(record);
+  drain();
+}
+
+void BinaryReporter::run_finished(const Orchestrator &)
+{
+  if (file_ != nullptr)
+  {
+    std::fclose(file_);
+    file_ = nullptr;
+    std::cout << "Results written to: " << path_ << "\n";
+  }
+}
+
+} // namespace tUnit
@@ -0,0 +1,204 @@
+#include "tUnit/result_format.h"
+
+namespace tUnit
+{
+namespace result_format
+{
+
+Writer::Writer()
+{
+  out_.bytes().append(magic);
+  out_.u32(version);
+}
+
+std::uint32_t Writer::id(std::string_view text)
+{
+  auto it = ids_.find(std::string(text));
+  if (it != ids_.end())
+  {
+    return it->second;
+  }
+
+  const auto next = static_cast<std::uint32_t>(ids_.size());
+  ids_.emplace(std::string(text), next);
+  record(RecordType::string, std::string(text));
+  return next;
+}
+
+void Writer::record(RecordType type, const std::string &payload)
+{
+  out_.u8(static_cast<std::uint8_t>(type));
+  out_.u32(static_cast<std::uint32_t>(payload.size()));
+  out_.bytes().append(payload);
+}
+
+void Writer::add_test(const TestRecord &record)
+{
+  // String records must precede the test record that uses them
+  const std::uint32_t suite = id(record.suite_);
+  const std::uint32_t test = id(record.test_);
+  std::vector<std::uint32_t> benchmark_names;
+  for (const BenchmarkResult &benchmark : record.benchmarks_)
+  {
+    benchmark_names.push_back(id(benchmark.name_));
+  }
+  std::vector<std::uint32_t> failures;
+  failures.reserve(record.failures_.size());
+  for (std::string_view failure : record.failures_)
+  {
+    failures.push_back(id(failure));
+  }
+
+  payload_.clear();
+  payload_.u32(suite);
+  payload_.u32(test);
+  payload_.u64(record.assertions_);
+  payload_.u64(record.failed_);
+  payload_.u64(record.wall_ns_);
+  payload_.u32(static_cast<std::uint32_t>(failures.size()));
+  for (std::uint32_t failure : failures)
+  {
+    payload_.u32(failure);
+  }
+  payload_.u64(record.user_ns_);
+  payload_.u64(record.system_ns_);
+  payload_.u32(static_cast<std::uint32_t>(record.benchmarks_.size()));
+  for (size_t b = 0; b < record.benchmarks_.size(); ++b)
+  {
+    const BenchmarkResult &benchmark = record.benchmarks_[b];
+    payload_.u32(benchmark_names[b]);
+    payload_.u64(benchmark.iterations_);
+    payload_.u32(static_cast<std::uint32_t>(benchmark.samples_ns_.size()));
+    for (double sample : benchmark.samples_ns_)
+    {
+      payload_.f64(sample);
+    }
+  }
+  utils::put_counts(payload_, record.counters_);
+  for (const BenchmarkResult &benchmark : record.benchmarks_)
+  {
+    utils::put_counts(payload_, benchmark.counters_);
+  }
+  utils::put_allocations(payload_, record.allocations_);
+  this->record(RecordType::test, payload_.bytes());
+}
+
+bool read(std::string_view image, const std::function<void(const TestRecord &)> &on_test, std::string *error)
+{
+  auto fail = [error](const std::string &message)
+  {
+    if (error != nullptr)
+    {
+      *error = message;
+    }
+    return false;
+  };
+
+  if (!is_binary(image))
+  {
+    return fail("not a tUnit results file");
+  }
+  utils::ByteReader reader(image.substr(magic.size()));
+  std::uint32_t file_version = 0;
+  if (!reader.u32(file_version) || file_version != version)
+  {
+    return fail("unsupported results format version " + std::to_string(file_version));
+  }
+
+  std::vector<std::string_view> strings;
+  TestRecord record;
+  auto lookup = [&strings](std::uint32_t id, std::string_view &out)
+  {
+    if (id >= strings.size())
+    {
+      return false;
+    }
+    out = strings[id];
+    return true;
+  };
+
+  while (reader.remaining() > 0)
+  {
+    const size_t offset = image.size() - reader.remaining();
+    std::uint8_t type = 0;
+    std::string_view payload;
+    if (!reader.u8(type) || !reader.str(payload))
+    {
+      // e.g. the writer crashed mid-record: the complete records were delivered, the rest is lost
+      return fail("truncated record at byte " + std::to_string(offset));
+    }
+
+    if (type == static_cast<std::uint8_t>(RecordType::string))
+    {
+      strings.push_back(payload);
+    }
+    else if (type == static_cast<std::uint8_t>(RecordType::test))
+    {
+      utils::ByteReader fields(payload);
+      std::uint32_t suite = 0, test = 0, count = 0;
+      if (!fields.u32(suite) || !fields.u32(test) || !fields.u64(record.assertions_) || !fields.u64(record.failed_) ||
+          !fields.u64(record.wall_ns_) || !fields.u32(count) || !lookup(suite, record.suite_) || !lookup(test, record.test_))
+      {
+        return fail("corrupt test record");
+      }
+      // Counts are checked against the bytes left before anything is allocated for them
+      if (fields.remaining() / sizeof(std::uint32_t) < count)
+      {
+        return fail("corrupt test record");
+      }
+      record.failures_.resize(count);
+      for (auto &failure : record.failures_)
+      {
+        std::uint32_t id = 0;
+        if (!fields.u32(id) || !lookup(id, failure))
+        {
+          return fail("corrupt test record");
+        }
+      }
+      record.user_ns_ = record.system_ns_ = 0;
+      record.benchmarks_.clear();
+      record.counters_ = {};
+      record.allocations_ = {};
+      std::uint32_t benchmarks = 0;
+      if (fields.u64(record.user_ns_) && fields.u64(record.system_ns_) && fields.u32(benchmarks))
+      {
+        // Each benchmark takes at least its name, iterations and sample count
+        if (fields.remaining() / (2 * sizeof(std::uint32_t) + sizeof(std::uint64_t)) < benchmarks)
+        {
+          return fail("corrupt test record");
+        }
+        record.benchmarks_.resize(benchmarks);
+        for (BenchmarkResult &benchmark : record.benchmarks_)
+        {
+          std::uint32_t name = 0, samples = 0;
+          std::string_view name_text;
+          if (!fields.u32(name) || !lookup(name, name_text) || !fields.u64(benchmark.iterations_) || !fields.u32(samples) ||
+              fields.remaining() / sizeof(double) < samples)
+          {
+            return fail("corrupt benchmark in test record");
+          }
+          benchmark.name_ = name_text;
+          benchmark.samples_ns_.resize(samples);
+          for (double &sample : benchmark.samples_ns_)
+          {
+            fields.f64(sample);
+          }
+          detail::summarize(benchmark);
+        }
+        if (utils::get_counts(fields, record.counters_))
+        {
+          for (BenchmarkResult &benchmark : record.benchmarks_)
+          {
+            utils::get_counts(fields, benchmark.counters_);
+          }
+          utils::get_allocations(fields, record.allocations_);
+        }
+      }
+      on_test(record);
+    }
+  }
+  return true;
+}
+
+} // namespace result_format
+} // namespace tUnit
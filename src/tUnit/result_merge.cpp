@@ -0,0 +1,227 @@
+#include "tUnit/test_case.h"
+#include "tUnit/test_orchestrator.h"
+#include "tUnit/result_format.h"
+#include "tUnit/test_results.h"
+#include "utils/mapped_file.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tUnit
+{
+
+namespace
+{
+
+/**
+ * Just enough of an XML reader for the reports write_xml_output produces:
+ * walks start tags in order and exposes their attributes
+ */
+class TagScanner
+{
+public:
+  explicit TagScanner(std::string text) : text_(std::move(text)) {}
+
+  // Advances to the next start tag; false at end of input
+  bool next()
+  {
+    while ((pos_ = text_.find('<', pos_)) != std::string::npos)
+    {
+      size_t end = text_.find('>', pos_);
+      if (end == std::string::npos)
+      {
+        return false;
+      }
+      char first = text_[pos_ + 1];
+      tag_ = std::string_view(text_).substr(pos_ + 1, end - pos_ - 1);
+      pos_ = end + 1;
+      if (first != '/' && first != '?' && first != '!')
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::string_view name() const
+  {
+    return tag_.substr(0, tag_.find_first_of(" \t\r\n/"));
+  }
+
+  std::string attribute(std::string_view key) const
+  {
+    std::string pattern = " " + std::string(key) + "=\"";
+    size_t start = tag_.find(pattern);
+    if (start == std::string_view::npos)
+    {
+      return {};
+    }
+    start += pattern.size();
+    return unescape(tag_.substr(start, tag_.find('"', start) - start));
+  }
+
+private:
+  static std::string unescape(std::string_view value)
+  {
+    static constexpr std::pair<std::string_view, char> entities[] = {
+        {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}, {"&#13;", '\r'},
+        {"&#10;", '\n'}, {"&#9;", '\t'}};
+
+    std::string out;
+    out.reserve(value.size());
+    for (size_t i = 0; i < value.size(); ++i)
+    {
+      bool decoded = false;
+      if (value[i] == '&')
+      {
+        for (const auto &[entity, c] : entities)
+        {
+          if (value.substr(i, entity.size()) == entity)
+          {
+            out += c;
+            i += entity.size() - 1;
+            decoded = true;
+            break;
+          }
+        }
+      }
+      if (!decoded)
+      {
+        out += value[i];
+      }
+    }
+    return out;
+  }
+
+  std::string text_;
+  std::string_view tag_;
+  size_t pos_ = 0;
+};
+
+} // anonymous namespace
+
+// Passing descriptions are not stored in results files, so only their count carries over
+void Orchestrator::replay(Test &test, size_t passes, const std::vector<std::string_view> &failures, const TestTiming &timing,
+                          const std::vector<BenchmarkResult> &benchmarks)
+{
+  for (const BenchmarkResult &benchmark : benchmarks)
+  {
+    store_benchmark(*test.results_, benchmark);
+  }
+  for (std::string_view failure : failures)
+  {
+    log_assertion(*test.results_, failure, false);
+  }
+  if (passes > 0)
+  {
+    log_passed(*test.results_, passes);
+  }
+  test.timing_ = timing;
+
+  // Reporters see merged tests as if they had just run
+  if (has_listeners_.load(std::memory_order_relaxed))
+  {
+    notify_test_finished(test);
+  }
+}
+
+bool Orchestrator::load_results(const std::string &path)
+{
+  utils::MappedFile file(path);
+  if (!file.is_open())
+  {
+    std::cerr << "Error: Could not open results file: " << path << std::endl;
+    return false;
+  }
+  if (!result_format::is_binary(file.bytes()))
+  {
+    return load_xml_results(path);
+  }
+
+  std::string error;
+  bool ok = result_format::read(
+      file.bytes(), [this](const result_format::TestRecord &record)
+      {
+        Test &test = get_test(record.suite_, record.test_);
+        const size_t passes = record.assertions_ > record.failures_.size() ? record.assertions_ - record.failures_.size() : 0;
+        replay(test, passes, record.failures_, TestTiming{std::chrono::nanoseconds(record.wall_ns_), std::chrono::nanoseconds(record.user_ns_), std::chrono::nanoseconds(record.system_ns_), record.counters_, record.allocations_}, record.benchmarks_); },
+      &error);
+  if (!ok)
+  {
+    std::cerr << "Error: " << path << ": " << error << std::endl;
+  }
+  return ok;
+}
+
+bool Orchestrator::load_xml_results(const std::string &path)
+{
+  std::ifstream file(path);
+  if (!file.is_open())
+  {
+    std::cerr << "Error: Could not open results file: " << path << std::endl;
+    return false;
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+
+  // Tests before a cut are still replayed, but a report without its closing tag lost the rest
+  const bool complete = contents.str().find("</testsuites>") != std::string::npos;
+  TagScanner scanner(contents.str());
+  Test *current = nullptr;
+  size_t assertions = 0;
+  TestTiming timing;
+  std::vector<std::string> messages;
+
+  auto finish_test = [&]()
+  {
+    if (current == nullptr)
+    {
+      return;
+    }
+    std::vector<std::string_view> failures(messages.begin(), messages.end());
+    replay(*current, assertions > failures.size() ? assertions - failures.size() : 0, failures, timing, {});
+    current = nullptr;
+    messages.clear();
+  };
+
+  while (scanner.next())
+  {
+    std::string_view tag = scanner.name();
+    if (tag == "testcase")
+    {
+      finish_test();
+      current = &get_test(scanner.attribute("classname"), scanner.attribute("name"));
+      assertions = std::strtoull(scanner.attribute("assertions").c_str(), nullptr, 10);
+      // JUnit only carries wall time, in seconds
+      timing = TestTiming{};
+      timing.wall_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(std::strtod(scanner.attribute("time").c_str(), nullptr)));
+    }
+    else if (tag == "failure" && current != nullptr)
+    {
+      messages.push_back(scanner.attribute("message"));
+    }
+  }
+  finish_test();
+  if (!complete)
+  {
+    std::cerr << "Error: " << path << ": truncated or not a JUnit report" << std::endl;
+  }
+  return complete;
+}
+
+bool Orchestrator::merge(const std::vector<std::string> &paths)
+{
+  for (const auto &path : paths)
+  {
+    if (!load_results(path))
+    {
+      unreadable_results_.push_back(path);
+    }
+  }
+  notify_run_finished();
+  return unreadable_results_.empty();
+}
+
+} // namespace tUnit
@@ -1,25 +1,74 @@
 #include "tUnit/test_case.h"
 #include "tUnit/test_orchestrator.h"
+#include <sstream>
 
 namespace tUnit
 {
 
+std::string detail::describe_each(std::string_view description, const EachResult &result)
+{
+  std::ostringstream out;
+  out << description;
+  if (result.passed())
+  {
+    out << " (" << result.count_ << " elements)";
+    return out.str();
+  }
+  out << ":";
+  if (result.lhs_size_ != result.rhs_size_)
+  {
+    out << " lengths differ (" << result.lhs_size_ << " vs " << result.rhs_size_ << ")" << (result.failed_ > 0 ? ";" : "");
+  }
+  if (result.failed_ > 0)
+  {
+    out << " " << result.failed_ << " of " << result.count_ << " elements failed, first at " << result.failing_values_;
+    if (result.failed_ > result.first_failures_.size())
+    {
+      out << ", ...";
+    }
+  }
+  return out.str();
+}
+
 Test::Test(const std::string &suite_name, const std::string &name) : suite_name_(suite_name), name_(name) {}
 
-void Test::expect(const std::string &description, bool condition, bool expected)
+void Test::expect(std::string_view description, bool condition, bool expected)
 {
   bool passed = (condition == expected);
 
-  Assertion assertion(description, passed);
-
-  assertion_ids_.push_back(description);
+  Orchestrator::instance().log_assertion(*results_, description, passed);
+}
 
-  Orchestrator::instance().log_assertion(suite_name_, name_, std::move(assertion));
+void Test::check_no_allocations(std::string_view description, const utils::AllocationStats &stats)
+{
+  if (!stats.tracked_)
+  {
+    Orchestrator::instance().log_assertion(*results_, std::string(description) + ": not checked, the tunit_alloc allocation hooks are not linked", false);
+  }
+  else if (stats.allocations_ > 0)
+  {
+    Orchestrator::instance().log_assertion(*results_, std::string(description) + ": " + std::to_string(stats.allocations_) + " allocation(s), " + std::to_string(stats.bytes_) + " bytes", false);
+  }
+  else
+  {
+    Orchestrator::instance().log_assertion(*results_, description, true);
+  }
 }
+
 const std::string &Test::name() const { return name_; }
 
 const std::string &Test::suite_name() const { return suite_name_; }
 
+const TestResults &Test::results() const
+{
+  Orchestrator::instance().collect();
+  return *results_;
+}
+
+const TestTiming &Test::timing() const { return timing_; }
+
+std::chrono::nanoseconds Test::wall_time() const { return timing_.wall_; }
+
 // Helper function for template implementation
 Orchestrator &get_orchestrator_instance() { return Orchestrator::instance(); }
 
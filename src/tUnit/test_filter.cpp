@@ -0,0 +1,117 @@
+#include "tUnit/test_filter.h"
+#include "utils/trace_support.h"
+
+namespace tUnit
+{
+
+bool TestFilter::glob_match(std::string_view pattern, std::string_view text)
+{
+  // Iterative matcher: on mismatch, backtrack to the most recent '*' and let it absorb one more character
+  size_t p = 0;
+  size_t t = 0;
+  size_t star = std::string_view::npos;
+  size_t resume = 0;
+
+  while (t < text.size())
+  {
+    if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+    {
+      ++p;
+      ++t;
+    }
+    else if (p < pattern.size() && pattern[p] == '*')
+    {
+      star = p++;
+      resume = t;
+    }
+    else if (star != std::string_view::npos)
+    {
+      p = star + 1;
+      t = ++resume;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  while (p < pattern.size() && pattern[p] == '*')
+  {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+TestFilter::Pattern TestFilter::compile(std::string_view pattern, TagMask tags)
+{
+  Pattern compiled{Pattern::Kind::glob, std::string(pattern), {}, tags};
+  if (pattern.size() >= 2 && pattern.front() == '[' && pattern.back() == ']')
+  {
+    compiled.kind_ = Pattern::Kind::tags;
+  }
+  else if (pattern.size() >= 2 && pattern.front() == '/' && pattern.back() == '/')
+  {
+    compiled.kind_ = Pattern::Kind::regex;
+    try
+    {
+      compiled.regex_ = std::regex(std::string(pattern.substr(1, pattern.size() - 2)), std::regex::ECMAScript | std::regex::optimize);
+    }
+    catch (const std::regex_error &e)
+    {
+      tUnit::trace::throw_traced("Invalid test filter regex " + compiled.text_ + ": " + e.what());
+    }
+  }
+  return compiled;
+}
+
+void TestFilter::include(std::string_view pattern, TagMask tags)
+{
+  includes_.push_back(compile(pattern, tags));
+}
+
+void TestFilter::exclude(std::string_view pattern, TagMask tags)
+{
+  excludes_.push_back(compile(pattern, tags));
+}
+
+bool TestFilter::matches(const Pattern &pattern, std::string_view full_name, TagMask tags)
+{
+  switch (pattern.kind_)
+  {
+  case Pattern::Kind::tags:
+    return pattern.tags_.any() && (tags & pattern.tags_) == pattern.tags_;
+  case Pattern::Kind::regex:
+    return std::regex_search(full_name.begin(), full_name.end(), pattern.regex_);
+  case Pattern::Kind::glob:
+    return glob_match(pattern.text_, full_name);
+  }
+  return false;
+}
+
+bool TestFilter::selects(std::string_view full_name, TagMask tags) const
+{
+  bool included = includes_.empty();
+  for (const auto &pattern : includes_)
+  {
+    if (matches(pattern, full_name, tags))
+    {
+      included = true;
+      break;
+    }
+  }
+  if (!included)
+  {
+    return false;
+  }
+
+  for (const auto &pattern : excludes_)
+  {
+    if (matches(pattern, full_name, tags))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace tUnit
@@ -1,10 +1,17 @@
 #include "tUnit/test_orchestrator.h"
 #include "tUnit/assertion.h"
+#include "tUnit/reporters.h"
 #include "tUnit/test_case.h"
+#include "tUnit/test_results.h"
 #include "tUnit/test_suite.h"
+#include "utils/allocation_tracker.h"
+#include "utils/spin_lock.h"
 #include "utils/trace_support.h"
+#include "utils/xml_stream.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <cstring>
-#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -12,7 +19,78 @@
 namespace tUnit
 {
 
+namespace
+{
+
+/**
+ * Pending results for one test, as seen by one thread
+ */
+struct ShardSlot
+{
+  std::vector<Assertion> assertions_;
+  size_t total_ = 0;  // since the last collect
+  size_t failed_ = 0; // since the last collect
+  bool touched_ = false;
+};
+
+// The slot for index, marked as having pending results; requires the shard's lock
+ShardSlot &touch_slot(std::vector<ShardSlot> &slots, std::vector<size_t> &touched, size_t index)
+{
+  if (index >= slots.size())
+  {
+    slots.resize(index + 1);
+  }
+  ShardSlot &slot = slots[index];
+  if (!slot.touched_)
+  {
+    slot.touched_ = true;
+    touched.push_back(index);
+  }
+  return slot;
+}
+
+// Three significant digits in the largest fitting unit: "850 us", "12.3 ms", "1.20 s"
+std::string format_duration(std::chrono::nanoseconds duration)
+{
+  static constexpr std::pair<double, const char *> units[] = {{1e9, "s"}, {1e6, "ms"}, {1e3, "us"}, {1, "ns"}};
+  const double ns = static_cast<double>(duration.count());
+  for (const auto &[scale, name] : units)
+  {
+    if (ns >= scale || scale == 1)
+    {
+      const double value = ns / scale;
+      std::ostringstream out;
+      out << std::fixed << std::setprecision(value >= 100 || scale == 1 ? 0 : value >= 10 ? 1 : 2) << value << ' ' << name;
+      return out.str();
+    }
+  }
+  return {};
+}
+
+std::string format_rate(double per_second)
+{
+  std::ostringstream out;
+  out << std::setprecision(3) << per_second;
+  return out.str();
+}
+
+} // anonymous namespace
+
+/**
+ * Per-thread assertion buffer; the owning thread is the only writer, so its lock is
+ * uncontended except while collect() drains it. Cache-line aligned so that no two shards'
+ * locks share a line.
+ */
+struct alignas(64) Orchestrator::ResultShard
+{
+  utils::SpinLock lock_;
+  std::vector<ShardSlot> slots_; // indexed by TestResults::slot_
+  std::vector<size_t> touched_;  // slots with pending results
+};
+
 Orchestrator *Orchestrator::instance_ = nullptr;
+thread_local Orchestrator::ResultShard *Orchestrator::local_shard_ = nullptr;
+
 Orchestrator::~Orchestrator()
 {
   instance_ = nullptr;
@@ -27,7 +105,29 @@ Orchestrator &Orchestrator::instance()
   return *instance_;
 }
 
-Suite &Orchestrator::get_suite(const std::string &name)
+Suite &Orchestrator::get_suite(std::string_view name)
+{
+  utils::AllocationPause pause; // bookkeeping, not the test's allocation
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  return suite_for(name);
+}
+
+Test &Orchestrator::get_test(std::string_view suite_name, std::string_view test_name)
+{
+  utils::AllocationPause pause;
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  return test_for(suite_for(suite_name), test_name);
+}
+
+Test &Orchestrator::get_test(Suite &suite, std::string_view test_name)
+{
+  utils::AllocationPause pause;
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  return test_for(suite, test_name);
+}
+
+// Requires registry_mutex_
+Suite &Orchestrator::suite_for(std::string_view name)
 {
   auto it = suites_.find(name);
   if (it != suites_.end())
@@ -35,161 +135,403 @@ Suite &Orchestrator::get_suite(const std::string &name)
     return *(it->second);
   }
 
-  TUNIT_SCOPED_TRACE("creating suite: " + name);
-  suites_[name] = std::make_unique<Suite>(name);
-  return *(suites_[name]);
+  auto suite = std::make_unique<Suite>(std::string(name));
+  TUNIT_SCOPED_TRACE("creating suite: " + suite->name());
+  Suite &ref = *suite;
+  suites_.emplace(ref.name(), std::move(suite));
+  suite_order_.push_back(&ref);
+  return ref;
 }
 
-Test &Orchestrator::get_test(const std::string &suite_name, const std::string &test_name)
+// Requires registry_mutex_
+Test &Orchestrator::test_for(Suite &suite, std::string_view test_name)
 {
-  std::string test_key = suite_name + "::" + test_name;
-
-  auto it = tests_.find(test_key);
-  if (it != tests_.end())
+  auto it = suite.tests_.find(test_name);
+  if (it != suite.tests_.end())
   {
     return *(it->second);
   }
 
+  std::string test_key = suite.name() + "::" + std::string(test_name);
   TUNIT_SCOPED_TRACE("creating test: " + test_key);
-  tests_[test_key] = std::make_unique<Test>(suite_name, test_name);
-  return *(tests_[test_key]);
+
+  auto test = std::make_unique<Test>(suite.name(), std::string(test_name));
+  test->results_ = &results_[test_key];
+  test->results_->suite_counters_ = &suite.counters_;
+  test->results_->slot_ = results_by_slot_.size();
+  test->results_->test_ = test.get();
+  results_by_slot_.push_back(test->results_);
+
+  Test &ref = *test;
+  suite.tests_.emplace(ref.name(), &ref);
+  suite.test_order_.push_back(&ref);
+  tests_.emplace(std::move(test_key), std::move(test));
+  return ref;
+}
+
+Orchestrator::ResultShard &Orchestrator::local_shard()
+{
+  if (local_shard_ == nullptr)
+  {
+    std::lock_guard<std::mutex> guard(registry_mutex_);
+    shards_.push_back(std::make_unique<ResultShard>());
+    local_shard_ = shards_.back().get();
+  }
+  return *local_shard_;
 }
 
-void Orchestrator::log_assertion(const std::string &suite_name, const std::string &test_name, Assertion &&assertion)
+void Orchestrator::log_assertion(TestResults &results, Assertion &&assertion)
 {
-  std::string test_key = suite_name + "::" + test_name;
-  assertions_[test_key].emplace_back(std::move(assertion));
+  log_assertion(results, assertion.description_, assertion.result_);
 }
 
-const std::unordered_map<std::string, std::unique_ptr<Suite>> &Orchestrator::suites() const
+void Orchestrator::log_assertion(TestResults &results, std::string_view description, bool passed)
 {
-  return suites_;
+  utils::AllocationPause pause;
+  if (has_assertion_listeners_.load(std::memory_order_relaxed))
+  {
+    notify_assertion(results, description, passed);
+  }
+
+  ResultShard &shard = local_shard();
+  std::lock_guard<utils::SpinLock> guard(shard.lock_);
+  ShardSlot &slot = touch_slot(shard.slots_, shard.touched_, results.slot_);
+
+  ++slot.total_;
+  if (passed)
+  {
+    // Passing assertions that are not retained only bump counters
+    switch (retention_.load(std::memory_order_relaxed))
+    {
+    case Retention::all:
+      break;
+    case Retention::failures:
+      return;
+    case Retention::failures_and_first:
+      if (results.passes_seen_.fetch_add(1, std::memory_order_relaxed) >= pass_limit_.load(std::memory_order_relaxed)) return;
+      break;
+    }
+  }
+  else
+  {
+    ++slot.failed_;
+  }
+
+  slot.assertions_.emplace_back(descriptions_.intern(description), passed);
 }
 
-const std::unordered_map<std::string, std::unique_ptr<Test>> &Orchestrator::tests() const
+void Orchestrator::log_assertion(std::string_view suite_name, std::string_view test_name, Assertion &&assertion)
 {
-  return tests_;
+  log_assertion(*get_test(suite_name, test_name).results_, std::move(assertion));
 }
 
-const std::vector<Assertion> &Orchestrator::assertions_for(const std::string &suite_name, const std::string &test_name) const
+bool Orchestrator::log_unretained_pass(TestResults &results)
 {
-  std::string test_key = suite_name + "::" + test_name;
-  auto it = assertions_.find(test_key);
-  if (it != assertions_.end())
+  const Retention retention = retention_.load(std::memory_order_relaxed);
+  if (retention == Retention::all || has_assertion_listeners_.load(std::memory_order_relaxed))
   {
-    return it->second;
+    return false;
   }
-  tUnit::trace::throw_traced("No assertions found for test: " + test_key);
+
+  if (retention == Retention::failures_and_first &&
+      results.passes_seen_.load(std::memory_order_relaxed) < pass_limit_.load(std::memory_order_relaxed))
+  {
+    return false; // still within the first passes, which are stored with their descriptions
+  }
+
+  utils::AllocationPause pause;
+  ResultShard &shard = local_shard();
+  std::lock_guard<utils::SpinLock> guard(shard.lock_);
+  ++touch_slot(shard.slots_, shard.touched_, results.slot_).total_;
+  return true;
 }
 
-// High complexity:  O(S * T * A)
-bool Orchestrator::all_tests_passed() const
+void Orchestrator::log_benchmark(TestResults &results, const BenchmarkResult &benchmark)
+{
+  utils::AllocationPause pause;
+  store_benchmark(results, benchmark);
+  if (!baseline_.empty())
+  {
+    compare_to_baseline(results, benchmark);
+  }
+}
+
+void Orchestrator::store_benchmark(TestResults &results, const BenchmarkResult &benchmark)
 {
-  for (const auto &[test_key, assertions] : assertions_)
   {
-    for (const auto &assertion : assertions)
+    // Marks the test as changed for take_collected_slots_locked (an --isolate worker sends only those)
+    ResultShard &shard = local_shard();
+    std::lock_guard<utils::SpinLock> guard(shard.lock_);
+    touch_slot(shard.slots_, shard.touched_, results.slot_);
+  }
+  // Rare and large compared to assertions, so recorded straight into the canonical results
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  results.benchmarks_.push_back(benchmark);
+}
+
+// Requires registry_mutex_ and collected results
+TestOutcome Orchestrator::outcome_locked(const Test &test) const
+{
+  const TestResults &results = *test.results_;
+  TestOutcome outcome{test, results.total_, results.failed_, {}, test.timing_, results.benchmarks_};
+  outcome.failures_.reserve(results.failures_.size());
+  for (size_t index : results.failures_)
+  {
+    outcome.failures_.push_back(results.assertions_[index].description_); // interned, stays valid
+  }
+  return outcome;
+}
+
+void Orchestrator::log_passed(TestResults &results, size_t count)
+{
+  utils::AllocationPause pause;
+  ResultShard &shard = local_shard();
+  std::lock_guard<utils::SpinLock> guard(shard.lock_);
+  touch_slot(shard.slots_, shard.touched_, results.slot_).total_ += count;
+  results.passes_seen_.fetch_add(count, std::memory_order_relaxed);
+}
+
+// Requires registry_mutex_
+void Orchestrator::take_collected_slots_locked(std::vector<size_t> &slots) const
+{
+  collect_locked();
+  slots.swap(collected_slots_);
+  collected_slots_.clear();
+  std::sort(slots.begin(), slots.end());
+  slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+}
+
+void Orchestrator::collect() const
+{
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  collect_locked();
+}
+
+// Requires registry_mutex_
+void Orchestrator::collect_locked() const
+{
+  utils::AllocationPause pause; // merged results outlive the test that asked for them
+  for (const auto &shard : shards_)
+  {
+    std::lock_guard<utils::SpinLock> guard(shard->lock_);
+    for (size_t slot_index : shard->touched_)
     {
-      if (!assertion.result_)
+      if (worker_process_)
       {
-        return false;
+        collected_slots_.push_back(slot_index);
+      }
+      ShardSlot &slot = shard->slots_[slot_index];
+      TestResults &results = *results_by_slot_[slot_index];
+      ResultCounters &suite_counters = *results.suite_counters_;
+
+      if (results.failed_ == 0 && slot.failed_ > 0)
+      {
+        ++suite_counters.failed_tests_;
+        ++counters_.failed_tests_;
+      }
+      results.total_ += slot.total_;
+      results.failed_ += slot.failed_;
+      suite_counters.assertions_ += slot.total_;
+      suite_counters.failed_assertions_ += slot.failed_;
+      counters_.assertions_ += slot.total_;
+      counters_.failed_assertions_ += slot.failed_;
+
+      for (const Assertion &assertion : slot.assertions_)
+      {
+        if (!assertion.result_)
+        {
+          results.failures_.push_back(results.assertions_.size());
+        }
+        results.assertions_.push_back(assertion);
       }
+
+      slot.assertions_.clear();
+      slot.total_ = 0;
+      slot.failed_ = 0;
+      slot.touched_ = false;
     }
+    shard->touched_.clear();
   }
-  return true;
 }
 
-size_t Orchestrator::total_assertions() const
+const std::unordered_map<std::string_view, std::unique_ptr<Suite>> &Orchestrator::suites() const
+{
+  return suites_;
+}
+
+const std::unordered_map<std::string, std::unique_ptr<Test>> &Orchestrator::tests() const
+{
+  return tests_;
+}
+
+const std::vector<Suite *> &Orchestrator::suite_order() const
 {
-  size_t total = 0;
-  for (const auto &[test_key, assertions] : assertions_)
+  return suite_order_;
+}
+
+const std::vector<Assertion> &Orchestrator::assertions_for(std::string_view suite_name, std::string_view test_name) const
+{
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  collect_locked();
+  auto suite_it = suites_.find(suite_name);
+  if (suite_it != suites_.end())
   {
-    total += assertions.size();
+    const auto &tests = suite_it->second->tests_;
+    auto test_it = tests.find(test_name);
+    if (test_it != tests.end())
+    {
+      return test_it->second->results_->assertions_;
+    }
   }
-  return total;
+  tUnit::trace::throw_traced("No assertions found for test: " + std::string(suite_name) + "::" + std::string(test_name));
+}
+
+void Orchestrator::set_retention(Retention retention, size_t pass_limit)
+{
+  retention_ = retention;
+  pass_limit_ = pass_limit;
+}
+
+Retention Orchestrator::retention() const
+{
+  return retention_.load();
+}
+
+size_t Orchestrator::pass_limit() const
+{
+  return pass_limit_.load();
+}
+
+bool Orchestrator::all_tests_passed() const
+{
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  collect_locked();
+  return counters_.failed_assertions_ == 0 && unreadable_results_.empty();
+}
+
+size_t Orchestrator::total_assertions() const
+{
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  collect_locked();
+  return counters_.assertions_;
 }
 
 size_t Orchestrator::failed_assertions() const
 {
-  size_t failed = 0;
-  for (const auto &[test_key, assertions] : assertions_)
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  collect_locked();
+  return counters_.failed_assertions_;
+}
+
+size_t Orchestrator::failed_tests() const
+{
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  collect_locked();
+  return counters_.failed_tests_;
+}
+
+const ResultCounters &Orchestrator::counters() const
+{
+  collect();
+  return counters_;
+}
+
+// Requires collected results
+void Orchestrator::print_slowest() const
+{
+  std::vector<const Test *> ranked;
+  for (const Suite *suite : suite_order_)
   {
-    for (const auto &assertion : assertions)
-    {
-      if (!assertion.result_)
-      {
-        failed++;
-      }
-    }
+    ranked.insert(ranked.end(), suite->test_order_.begin(), suite->test_order_.end());
+  }
+  const size_t shown = std::min(slowest_, ranked.size());
+  std::partial_sort(ranked.begin(), ranked.begin() + shown, ranked.end(), [](const Test *a, const Test *b)
+                    { return a->timing_.wall_ > b->timing_.wall_; });
+
+  std::cout << "--- Slowest " << shown << " Tests ---\n";
+  for (size_t i = 0; i < shown; ++i)
+  {
+    const TestTiming &timing = ranked[i]->timing_;
+    std::cout << std::setw(10) << format_duration(timing.wall_) << "  " << ranked[i]->suite_name() << "::" << ranked[i]->name()
+              << "  (user " << format_duration(timing.user_) << ", sys " << format_duration(timing.system_) << ")\n";
   }
-  return failed;
+  std::cout << "\n";
 }
 
 void Orchestrator::print_summary() const
 {
+  if (list_only_)
+  {
+    return;
+  }
+  collect();
   size_t total = total_assertions();
   size_t failed = failed_assertions();
   size_t passed = total - failed;
 
   std::cout << "\n";
 
-  // Group tests by suite
-  std::unordered_map<std::string, std::vector<std::pair<std::string, const Test *>>> suites_map;
-  for (const auto &[test_key, test] : tests_)
+  for (const Suite *suite : suite_order_)
   {
-    suites_map[test->suite_name()].emplace_back(test->name(), test.get());
-  }
-
-  for (const auto &[suite_name, suite_tests] : suites_map)
-  {
-    std::cout << "--- " << suite_name << " ---\n";
-
-    for (const auto &[test_name, test] : suite_tests)
+    // Suites whose tests were all filtered out (or never created) are not reported
+    if (suite->test_order_.empty())
     {
-      std::string test_key = test->suite_name() + "::" + test->name();
-      auto assertions_it = assertions_.find(test_key);
-
-      bool test_has_failures = false;
-      std::vector<std::string> failed_descriptions;
+      continue;
+    }
+    std::cout << "--- " << suite->name() << " ---\n";
 
-      if (assertions_it != assertions_.end())
+    for (const Test *test : suite->test_order_)
+    {
+      const TestResults &results = *test->results_;
+      std::cout << (results.passed() ? "[PASS] " : "[FAIL] ") << test->name();
+      if (test->timing_.wall_.count() > 0)
       {
-        const auto &assertions = assertions_it->second;
-        for (const auto &assertion : assertions)
-        {
-          if (!assertion.result_)
-          {
-            test_has_failures = true;
-            failed_descriptions.push_back(assertion.description_);
-          }
-        }
+        std::cout << " (" << format_duration(test->timing_.wall_) << ")";
       }
-
-      if (test_has_failures)
+      std::cout << "\n";
+      if (test->timing_.counters_.any())
       {
-        std::cout << "[FAIL] " << test_name << "\n";
-        for (const auto &desc : failed_descriptions)
+        std::cout << "       " << utils::format_counts(test->timing_.counters_) << "\n";
+      }
+      for (const BenchmarkResult &benchmark : results.benchmarks_)
+      {
+        std::cout << "       " << benchmark.name_ << ": median " << format_duration(std::chrono::nanoseconds(static_cast<std::int64_t>(benchmark.median_ns_)))
+                  << ", mean " << format_duration(std::chrono::nanoseconds(static_cast<std::int64_t>(benchmark.mean_ns_)))
+                  << " +/- " << format_duration(std::chrono::nanoseconds(static_cast<std::int64_t>(benchmark.stddev_ns_)))
+                  << ", " << format_rate(benchmark.ops_per_second()) << " ops/s\n";
+        if (benchmark.counters_.any())
         {
-          std::cout << "       " << desc << "\n";
+          std::cout << "         per iteration: " << utils::format_counts(benchmark.counters_, benchmark.measured_iterations()) << "\n";
         }
       }
-      else
+      for (size_t index : results.failures_)
       {
-        std::cout << "[PASS] " << test_name << "\n";
+        std::cout << "       " << results.assertions_[index].description_ << "\n";
       }
     }
     std::cout << "\n";
   }
 
+  if (slowest_ > 0)
+  {
+    print_slowest();
+  }
+
   std::cout << "--- Total Summary ---\n";
   std::cout << "Total assertions: " << total << "\n";
   std::cout << "Passed: " << passed << "\n";
   std::cout << "Failed: " << failed << "\n";
 
-  if (failed == 0)
+  for (const std::string &path : unreadable_results_)
+  {
+    std::cout << "Results lost: " << path << " could not be read\n";
+  }
+
+  if (failed == 0 && unreadable_results_.empty())
   {
     std::cout << "All tests passed!\n";
   }
-  else
+  else if (failed > 0)
   {
     std::cout << failed << " assertion(s) failed\n";
   }
@@ -199,6 +541,7 @@ void Orchestrator::print_summary() const
 
 void Orchestrator::parse_args(int argc, char *argv[])
 {
+  std::vector<std::string> junit_paths; // added after the loop, once -f is known
   for (int i = 1; i < argc; ++i)
   {
     if (std::strcmp(argv[i], "-C") == 0 && i + 1 < argc)
@@ -210,148 +553,277 @@ void Orchestrator::parse_args(int argc, char *argv[])
     {
       failures_only_ = true;
     }
+    else if (std::strcmp(argv[i], "-j") == 0)
+    {
+      // -j <N> runs N tests in parallel; a bare -j (or -j 0) uses every hardware thread
+      jobs_ = 0;
+      if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0])))
+      {
+        jobs_ = std::strtoull(argv[++i], nullptr, 10);
+      }
+    }
+    else if ((std::strcmp(argv[i], "--filter") == 0 || std::strcmp(argv[i], "--exclude") == 0) && i + 1 < argc)
+    {
+      // Patterns: glob on suite::test, /regex/, or [tag][tag]
+      bool include = std::strcmp(argv[i], "--filter") == 0;
+      std::string_view pattern = argv[++i];
+      TagMask tags = !pattern.empty() && pattern.front() == '[' ? tag_mask(pattern) : TagMask{};
+      if (include)
+      {
+        filter_.include(pattern, tags);
+      }
+      else
+      {
+        filter_.exclude(pattern, tags);
+      }
+    }
+    else if (std::strcmp(argv[i], "--slowest") == 0 && i + 1 < argc)
+    {
+      slowest_ = std::strtoull(argv[++i], nullptr, 10);
+    }
+    else if (std::strcmp(argv[i], "--list") == 0)
+    {
+      list_only_ = true;
+    }
+    else if (std::strcmp(argv[i], "--reporter") == 0 && i + 1 < argc)
+    {
+      // --reporter console|tap|jsonl|junit, optionally :<file> (junit requires one)
+      std::string_view spec = argv[++i];
+      size_t colon = spec.find(':');
+      std::string_view kind = spec.substr(0, colon);
+      std::string path = colon == std::string_view::npos ? std::string() : std::string(spec.substr(colon + 1));
+      if (kind == "console")
+      {
+        add_listener(std::make_unique<ConsoleReporter>(path));
+      }
+      else if (kind == "tap")
+      {
+        add_listener(std::make_unique<TapReporter>(path));
+      }
+      else if (kind == "jsonl")
+      {
+        add_listener(std::make_unique<JsonLinesReporter>(path));
+      }
+      else if (kind == "junit" && !path.empty())
+      {
+        junit_paths.push_back(path);
+      }
+      else
+      {
+        std::cerr << "Error: Unknown reporter: " << spec << std::endl;
+        std::exit(2);
+      }
+    }
+    else if (std::strcmp(argv[i], "--results") == 0 && i + 1 < argc)
+    {
+      results_output_path_ = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--fail-leaks") == 0)
+    {
+      fail_leaks_ = true;
+    }
+    else if (std::strcmp(argv[i], "--perf-counters") == 0)
+    {
+      utils::enable_perf_counters();
+    }
+    else if (std::strcmp(argv[i], "--save-baseline") == 0 && i + 1 < argc)
+    {
+      save_baseline_path_ = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--compare-baseline") == 0 && i + 1 < argc)
+    {
+      // A missing baseline must not silently turn the regression gate off
+      if (!load_baseline(argv[++i]))
+      {
+        std::exit(2);
+      }
+    }
+    else if (std::strcmp(argv[i], "--regression-threshold") == 0 && i + 1 < argc)
+    {
+      regression_threshold_ = std::strtod(argv[++i], nullptr) / 100.0; // given in percent
+    }
+    else if (std::strcmp(argv[i], "--regression-alpha") == 0 && i + 1 < argc)
+    {
+      regression_alpha_ = std::strtod(argv[++i], nullptr);
+    }
+    else if (std::strcmp(argv[i], "--isolate") == 0)
+    {
+      isolate_ = true;
+    }
+    else if ((std::strcmp(argv[i], "--timeout") == 0 || std::strcmp(argv[i], "--test-timeout") == 0) && i + 1 < argc)
+    {
+      test_timeout_ = std::strtod(argv[++i], nullptr);
+    }
+    else if (std::strcmp(argv[i], "--memory-limit") == 0 && i + 1 < argc)
+    {
+      memory_limit_mb_ = std::strtoull(argv[++i], nullptr, 10);
+    }
+    else if (std::strcmp(argv[i], "--shard-index") == 0 && i + 1 < argc)
+    {
+      shard_index_ = std::strtoull(argv[++i], nullptr, 10);
+    }
+    else if (std::strcmp(argv[i], "--shard-count") == 0 && i + 1 < argc)
+    {
+      shard_count_ = std::max<size_t>(1, std::strtoull(argv[++i], nullptr, 10));
+    }
+    else if (std::strcmp(argv[i], "--shard-timings") == 0 && i + 1 < argc)
+    {
+      load_shard_timings(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--save-timings") == 0 && i + 1 < argc)
+    {
+      timings_output_path_ = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--merge") == 0)
+    {
+      // --merge a.xml b.xml ...: every following argument up to the next option
+      while (i + 1 < argc && argv[i + 1][0] != '-')
+      {
+        merge_inputs_.emplace_back(argv[++i]);
+      }
+    }
+    else if (std::strcmp(argv[i], "--retain") == 0 && i + 1 < argc)
+    {
+      // --retain all | failures | <N>: failures plus the first N passes of each test
+      const char *value = argv[++i];
+      if (std::strcmp(value, "all") == 0)
+      {
+        set_retention(Retention::all);
+      }
+      else if (std::strcmp(value, "failures") == 0)
+      {
+        set_retention(Retention::failures);
+      }
+      else
+      {
+        // Digits only: strtoull would read a typo such as "failure" as 0
+        char *end = nullptr;
+        const unsigned long long pass_limit = std::strtoull(value, &end, 10);
+        if (!std::isdigit(static_cast<unsigned char>(value[0])) || *end != '\0')
+        {
+          std::cerr << "Error: --retain " << value << ": expected all, failures or a number of passes to keep" << std::endl;
+          std::exit(2);
+        }
+        set_retention(Retention::failures_and_first, pass_limit);
+      }
+    }
+  }
+
+  if (shard_index_ >= shard_count_)
+  {
+    std::cerr << "Error: --shard-index " << shard_index_ << " is out of range for --shard-count " << shard_count_ << std::endl;
+    std::exit(2);
+  }
+
+  // -C streams like --reporter junit:<file> once the shard index is known
+  if (!xml_output_path_.empty() && !list_only_)
+  {
+    junit_paths.push_back(xml_output_path());
+  }
+  for (std::string &path : junit_paths)
+  {
+    add_listener(std::make_unique<JUnitReporter>(std::move(path), failures_only_));
+  }
+  if (!results_output_path_.empty() && !list_only_)
+  {
+    add_listener(std::make_unique<BinaryReporter>(shard_path(results_output_path_)));
   }
 }
 
-void Orchestrator::write_xml_output() const
+std::string Orchestrator::xml_output_path() const
+{
+  return shard_path(xml_output_path_);
+}
+
+// "{shard}" in an output path expands to the shard index so sharded processes do not overwrite each other
+std::string Orchestrator::shard_path(std::string path) const
 {
-  // No XML output requested
-  if (xml_output_path_.empty())
+  size_t pos = path.find("{shard}");
+  if (pos != std::string::npos)
   {
-    return; 
+    path.replace(pos, 7, std::to_string(shard_index_));
   }
+  return path;
+}
 
-  std::ofstream xml_file(xml_output_path_);
-  if (!xml_file.is_open())
+void Orchestrator::write_xml_output() const
+{
+  // No XML output requested, or only listing tests; after run() the -C reporter has written it
+  if (xml_output_path_.empty() || list_only_ || run_finished_)
   {
-    std::cerr << "Error: Could not open XML output file: " << xml_output_path_ << std::endl;
     return;
   }
+  write_junit(xml_output_path());
+}
 
-  // Test statistics
-  size_t total_tests = tests_.size();
-  size_t failed_tests = 0;
-  size_t total_assertions = 0;
-  size_t failed_assertions = 0;
-
-  for (const auto &[test_key, test] : tests_)
+bool Orchestrator::write_junit(const std::string &path) const
+{
+  utils::XmlStream xml(path);
+  if (!xml.is_open())
   {
-    auto assertions_it = assertions_.find(test_key);
-    if (assertions_it != assertions_.end())
-    {
-      const auto &assertions = assertions_it->second;
-      total_assertions += assertions.size();
-
-      bool test_failed = false;
-      for (const auto &assertion : assertions)
-      {
-        if (!assertion.result_)
-        {
-          failed_assertions++;
-          test_failed = true;
-        }
-      }
-      if (test_failed)
-      {
-        failed_tests++;
-      }
-    }
+    std::cerr << "Error: Could not open XML output file: " << path << std::endl;
+    return false;
   }
 
-  // XML header
-  xml_file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-  xml_file << "<testsuites tests=\"" << total_tests << "\" failures=\"" << failed_tests
-           << "\" assertions=\"" << total_assertions << "\" failed_assertions=\"" << failed_assertions << "\">\n";
+  // Counters are complete after collect, so the report streams out in one pass over the tests
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  collect_locked();
 
-  // Group tests by suite
-  std::unordered_map<std::string, std::vector<std::pair<std::string, const Test *>>> suites_map;
-  for (const auto &[test_key, test] : tests_)
+  xml.raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites tests=\"").number(tests_.size());
+  xml.raw("\" failures=\"").number(counters_.failed_tests_);
+  xml.raw("\" assertions=\"").number(counters_.assertions_);
+  xml.raw("\" failed_assertions=\"").number(counters_.failed_assertions_);
+  std::chrono::nanoseconds run_time{0};
+  for (const Suite *suite : suite_order_)
   {
-    suites_map[test->suite_name()].emplace_back(test->name(), test.get());
+    for (const Test *test : suite->test_order_)
+    {
+      run_time += test->timing_.wall_;
+    }
   }
+  xml.raw("\" time=\"").seconds(run_time).raw("\">\n");
 
-  // Write each test suite
-  for (const auto &[suite_name, suite_tests] : suites_map)
+  for (const Suite *suite : suite_order_)
   {
-    size_t suite_test_count = suite_tests.size();
-    size_t suite_failures = 0;
-
-    // Count failures in this suite
-    for (const auto &[test_name, test] : suite_tests)
+    if (suite->test_order_.empty())
     {
-      std::string test_key = test->suite_name() + "::" + test->name();
-      auto assertions_it = assertions_.find(test_key);
-      if (assertions_it != assertions_.end())
-      {
-        const auto &assertions = assertions_it->second;
-        for (const auto &assertion : assertions)
-        {
-          if (!assertion.result_)
-          {
-            suite_failures++;
-            break; // Count as one failed test, not per assertion
-          }
-        }
-      }
+      continue;
     }
-
-    xml_file << "  <testsuite name=\"" << suite_name << "\" tests=\"" << suite_test_count
-             << "\" failures=\"" << suite_failures << "\">\n";
-
-    // Write individual test cases
-    for (const auto &[test_name, test] : suite_tests)
+    xml.raw("  <testsuite name=\"").attribute(suite->name());
+    xml.raw("\" tests=\"").number(suite->test_order_.size());
+    xml.raw("\" failures=\"").number(suite->counters_.failed_tests_);
+    std::chrono::nanoseconds suite_time{0};
+    for (const Test *test : suite->test_order_)
     {
-      std::string test_key = test->suite_name() + "::" + test->name();
-      auto assertions_it = assertions_.find(test_key);
-      bool test_has_failures = false;
+      suite_time += test->timing_.wall_;
+    }
+    xml.raw("\" time=\"").seconds(suite_time).raw("\">\n");
 
-      // Check if test has failures
-      if (assertions_it != assertions_.end())
-      {
-        const auto &assertions = assertions_it->second;
-        for (const auto &assertion : assertions)
-        {
-          if (!assertion.result_)
-          {
-            test_has_failures = true;
-            break;
-          }
-        }
-      }
+    for (const Test *test : suite->test_order_)
+    {
+      const TestResults &results = *test->results_;
 
       // Skip passed tests if failures_only_ is true
-      if (failures_only_ && !test_has_failures)
+      if (failures_only_ && results.passed())
       {
         continue;
       }
 
-      xml_file << "    <testcase name=\"" << test_name << "\" classname=\"" << suite_name << "\">\n";
-
-      // Add failure details if any
-      if (test_has_failures && assertions_it != assertions_.end())
-      {
-        const auto &assertions = assertions_it->second;
-        for (const auto &assertion : assertions)
-        {
-          if (!assertion.result_)
-          {
-            xml_file << "      <failure message=\"" << assertion.description_ << "\">\n";
-            xml_file << "        " << assertion.description_ << "\n";
-            xml_file << "      </failure>\n";
-          }
-        }
-      }
-
-      xml_file << "    </testcase>\n";
+      write_junit_testcase(xml, outcome_locked(*test));
     }
 
-    xml_file << "  </testsuite>\n";
+    xml.raw("  </testsuite>\n");
   }
 
-  xml_file << "</testsuites>\n";
-  xml_file.close();
+  xml.raw("</testsuites>\n");
+  if (!xml.close())
+  {
+    std::cerr << "Error: Could not write XML output file: " << path << std::endl;
+    return false;
+  }
 
-  std::cout << "XML output written to: " << xml_output_path_ << std::endl;
+  std::cout << "XML output written to: " << path << "\n";
+  return true;
 }
 
 } // namespace tUnit
@@ -0,0 +1,605 @@
+#include "tUnit/test_case.h"
+#include "tUnit/test_orchestrator.h"
+#include "tUnit/test_registry.h"
+#include "tUnit/test_suite.h"
+#include "utils/allocation_tracker.h"
+#include "utils/cpu_time.h"
+#include "utils/hash.h"
+#include "utils/perf_events.h"
+#include "utils/trace_support.h"
+#include "utils/watchdog.h"
+#include "utils/work_stealing_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tUnit
+{
+
+namespace
+{
+
+// Whether a lock the timed-out test's thread may hold forever comes free in time; released again
+bool free_within(std::mutex &mutex, std::chrono::steady_clock::duration patience)
+{
+  const auto deadline = std::chrono::steady_clock::now() + patience;
+  while (!mutex.try_lock())
+  {
+    if (std::chrono::steady_clock::now() >= deadline)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  mutex.unlock();
+  return true;
+}
+
+} // anonymous namespace
+
+Registrar::Registrar(void (*body)(Test &), const char *suite_name, const char *test_name, const char *tags, double timeout)
+{
+  Orchestrator::instance().register_test(suite_name, test_name, body, tags, timeout);
+}
+
+StaticAssertionRegistrar::StaticAssertionRegistrar(const char *file, int line, const char *expression, bool passed)
+{
+  Orchestrator::instance().register_static_assertion(file, line, expression, passed);
+}
+
+void Orchestrator::register_test(std::string suite_name, std::string test_name, std::function<void(Test &)> body, std::string_view tags,
+                                 double timeout)
+{
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  registrations_.push_back(TestRegistration{std::move(suite_name), std::move(test_name), std::move(body), tag_mask_locked(tags), timeout});
+}
+
+void Orchestrator::register_static_assertion(std::string_view file, int line, std::string_view expression, bool passed)
+{
+  // The path as compiled, not its basename: same-named files in two directories stay apart
+  std::string test_name(file);
+  std::string description = test_name + ":" + std::to_string(line) + ": " + std::string(expression);
+
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  auto &checks = static_assertions_[test_name];
+  if (checks.empty())
+  {
+    auto body = [this, &checks](Test &test)
+    {
+      for (const auto &[check, check_passed] : checks)
+      {
+        log_assertion(*test.results_, check, check_passed);
+      }
+    };
+    registrations_.push_back(TestRegistration{"Static Assertions", test_name, body, tag_mask_locked("[static]"), 0});
+  }
+  checks.emplace_back(std::move(description), passed);
+}
+
+TagMask Orchestrator::tag_mask(std::string_view tags)
+{
+  utils::AllocationPause pause;
+  std::lock_guard<std::mutex> guard(registry_mutex_);
+  return tag_mask_locked(tags);
+}
+
+// Requires registry_mutex_
+TagMask Orchestrator::tag_mask_locked(std::string_view tags)
+{
+  TagMask mask;
+  size_t open = tags.find('[');
+  while (open != std::string_view::npos)
+  {
+    size_t close = tags.find(']', open);
+    if (close == std::string_view::npos)
+    {
+      break;
+    }
+    std::string_view name = tags.substr(open + 1, close - open - 1);
+
+    auto it = std::find(tag_names_.begin(), tag_names_.end(), name);
+    if (it == tag_names_.end())
+    {
+      if (tag_names_.size() == mask.size())
+      {
+        tUnit::trace::throw_traced("Too many distinct test tags, limit is " + std::to_string(mask.size()));
+      }
+      it = tag_names_.insert(tag_names_.end(), std::string(name));
+    }
+    mask.set(static_cast<size_t>(it - tag_names_.begin()));
+    open = tags.find('[', close);
+  }
+  return mask;
+}
+
+std::string Orchestrator::tag_names(TagMask tags) const
+{
+  std::string names;
+  for (size_t bit = 0; bit < tag_names_.size(); ++bit)
+  {
+    if (tags.test(bit))
+    {
+      names += "[" + tag_names_[bit] + "]";
+    }
+  }
+  return names;
+}
+
+TestFilter &Orchestrator::filter()
+{
+  return filter_;
+}
+
+// Indices of the registrations that pass the filter, in registration order
+std::vector<size_t> Orchestrator::selected_registrations() const
+{
+  std::vector<size_t> selected;
+  selected.reserve(registrations_.size());
+  std::string full_name;
+  for (size_t i = 0; i < registrations_.size(); ++i)
+  {
+    const auto &registration = registrations_[i];
+    if (!filter_.empty())
+    {
+      full_name.assign(registration.suite_name_).append("::").append(registration.test_name_);
+      if (!filter_.selects(full_name, registration.tags_))
+      {
+        continue;
+      }
+    }
+    selected.push_back(i);
+  }
+
+  if (shard_count_ > 1)
+  {
+    select_shard(selected);
+  }
+  return selected;
+}
+
+// Keeps only this process's share of the selected tests. Every shard computes the same split
+// from the same inputs, so the shards are disjoint and together cover every selected test.
+void Orchestrator::select_shard(std::vector<size_t> &selected) const
+{
+  std::vector<std::uint64_t> hashes(selected.size());
+  for (size_t i = 0; i < selected.size(); ++i)
+  {
+    const auto &registration = registrations_[selected[i]];
+    hashes[i] = utils::fnv1a(registration.suite_name_ + "::" + registration.test_name_);
+  }
+
+  std::vector<size_t> kept;
+  if (shard_timings_.empty())
+  {
+    for (size_t i = 0; i < selected.size(); ++i)
+    {
+      if (hashes[i] % shard_count_ == shard_index_)
+      {
+        kept.push_back(selected[i]);
+      }
+    }
+    selected = std::move(kept);
+    return;
+  }
+
+  // Duration-balanced: longest-processing-time-first onto the least loaded shard.
+  // Tests missing from the timing file are assumed to take the mean known duration.
+  double known_total = 0;
+  size_t known_count = 0;
+  std::vector<double> durations(selected.size(), -1.0);
+  for (size_t i = 0; i < selected.size(); ++i)
+  {
+    const auto &registration = registrations_[selected[i]];
+    auto it = shard_timings_.find(registration.suite_name_ + "::" + registration.test_name_);
+    if (it != shard_timings_.end())
+    {
+      durations[i] = it->second;
+      known_total += it->second;
+      ++known_count;
+    }
+  }
+  const double fallback = known_count > 0 ? known_total / known_count : 1.0;
+  for (double &duration : durations)
+  {
+    if (duration < 0)
+    {
+      duration = fallback;
+    }
+  }
+
+  std::vector<size_t> order(selected.size());
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+            { return durations[a] != durations[b] ? durations[a] > durations[b] : hashes[a] < hashes[b]; });
+
+  std::vector<double> load(shard_count_, 0.0);
+  std::vector<bool> mine(selected.size(), false);
+  for (size_t i : order)
+  {
+    size_t target = static_cast<size_t>(std::min_element(load.begin(), load.end()) - load.begin());
+    load[target] += durations[i];
+    mine[i] = target == shard_index_;
+  }
+
+  for (size_t i = 0; i < selected.size(); ++i)
+  {
+    if (mine[i])
+    {
+      kept.push_back(selected[i]);
+    }
+  }
+  selected = std::move(kept);
+}
+
+// Timing file format: one "suite::test<TAB>seconds" line per test
+bool Orchestrator::load_shard_timings(const std::string &path)
+{
+  std::ifstream file(path);
+  if (!file.is_open())
+  {
+    std::cerr << "Error: Could not open timing file: " << path << std::endl;
+    return false;
+  }
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    size_t tab = line.rfind('\t');
+    if (tab == std::string::npos)
+    {
+      continue;
+    }
+    shard_timings_[line.substr(0, tab)] = std::strtod(line.c_str() + tab + 1, nullptr);
+  }
+  return true;
+}
+
+void Orchestrator::write_timings(const std::vector<Test *> &tests) const
+{
+  std::ofstream file(timings_output_path_);
+  if (!file.is_open())
+  {
+    std::cerr << "Error: Could not open timing file: " << timings_output_path_ << std::endl;
+    return;
+  }
+
+  for (const Test *test : tests)
+  {
+    file << test->suite_name() << "::" << test->name() << '\t'
+         << std::chrono::duration<double>(test->wall_time()).count() << '\n';
+  }
+}
+
+const std::vector<TestRegistration> &Orchestrator::registrations() const
+{
+  return registrations_;
+}
+
+void Orchestrator::list_tests() const
+{
+  for (size_t index : selected_registrations())
+  {
+    const auto &registration = registrations_[index];
+    std::cout << registration.suite_name_ << "::" << registration.test_name_;
+    if (registration.tags_.any())
+    {
+      std::cout << " " << tag_names(registration.tags_);
+    }
+    std::cout << "\n";
+  }
+  std::cout << std::flush;
+}
+
+void Orchestrator::add_listener(std::unique_ptr<Listener> listener)
+{
+  if (listener->wants_assertions())
+  {
+    assertion_listeners_.push_back(listener.get());
+    has_assertion_listeners_.store(true, std::memory_order_relaxed);
+  }
+  listeners_.push_back(std::move(listener));
+  has_listeners_.store(true, std::memory_order_relaxed);
+}
+
+// Event dispatch; callers check has_listeners_ (has_assertion_listeners_ for assertions) first, so
+// an unobserved run makes no virtual calls
+void Orchestrator::notify_test_started(const Test &test)
+{
+  std::lock_guard<std::mutex> guard(listener_mutex_);
+  for (auto &listener : listeners_)
+  {
+    listener->test_started(test);
+  }
+}
+
+void Orchestrator::notify_assertion(const TestResults &results, std::string_view description, bool passed)
+{
+  std::lock_guard<std::mutex> guard(listener_mutex_);
+  for (Listener *listener : assertion_listeners_)
+  {
+    listener->assertion_logged(*results.test_, description, passed);
+  }
+}
+
+void Orchestrator::notify_test_finished(Test &test)
+{
+  TestOutcome outcome = [this, &test]()
+  {
+    std::lock_guard<std::mutex> guard(registry_mutex_);
+    collect_locked();
+    return outcome_locked(test);
+  }();
+
+  std::lock_guard<std::mutex> guard(listener_mutex_);
+  test.reported_ = true;
+  for (auto &listener : listeners_)
+  {
+    listener->test_finished(outcome);
+  }
+}
+
+void Orchestrator::notify_run_finished()
+{
+  run_finished_ = true;
+  if (!has_listeners_.load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  // Tests that bodies created with get_test never ran on their own; they end with the run
+  std::vector<Test *> unreported;
+  {
+    std::lock_guard<std::mutex> guard(registry_mutex_);
+    for (const Suite *suite : suite_order_)
+    {
+      for (Test *test : suite->test_order_)
+      {
+        if (!test->reported_)
+        {
+          unreported.push_back(test);
+        }
+      }
+    }
+  }
+  for (Test *test : unreported)
+  {
+    notify_test_finished(*test);
+  }
+
+  std::lock_guard<std::mutex> guard(listener_mutex_);
+  for (auto &listener : listeners_)
+  {
+    listener->run_finished(*this);
+  }
+}
+
+void Orchestrator::run()
+{
+  run(jobs_);
+}
+
+void Orchestrator::run(size_t jobs)
+{
+  if (list_only_)
+  {
+    list_tests();
+    return;
+  }
+
+  // Merge mode: report on previously written shard results instead of running anything
+  if (!merge_inputs_.empty())
+  {
+    merge(merge_inputs_);
+    return;
+  }
+
+  // Filtered-out tests are never created or executed
+  const std::vector<size_t> selected = selected_registrations();
+  leak_tag_ = tag_mask("[leaks]");
+
+  // Create every test up front, in registration order, so report order does not depend on scheduling
+  std::vector<Test *> tests;
+  tests.reserve(selected.size());
+  for (size_t index : selected)
+  {
+    tests.push_back(&get_test(registrations_[index].suite_name_, registrations_[index].test_name_));
+  }
+
+  if (jobs == 0)
+  {
+    jobs = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+  jobs = std::min(jobs, tests.size());
+
+  // Workers create their own: the watchdog thread would not survive the fork
+  std::optional<utils::Watchdog> watchdog;
+  if (!isolate_ && has_timeouts(selected))
+  {
+    watchdog_ = &watchdog.emplace();
+  }
+
+  if (isolate_ && !tests.empty())
+  {
+    // One worker process per job; -j keeps its meaning of "how many tests at once"
+    run_isolated(selected, tests, jobs);
+  }
+  else if (jobs <= 1)
+  {
+    for (size_t i = 0; i < tests.size(); ++i)
+    {
+      run_test(registrations_[selected[i]], *tests[i]);
+    }
+  }
+  else
+  {
+    // Each worker thread records into its own result shard
+    utils::WorkStealingPool pool(jobs);
+    pool.run(tests.size(), [this, &tests, &selected](size_t, size_t index)
+             { run_test(registrations_[selected[index]], *tests[index]); });
+  }
+
+  watchdog_ = nullptr;
+
+  if (!timings_output_path_.empty())
+  {
+    write_timings(tests);
+  }
+  if (!save_baseline_path_.empty())
+  {
+    save_baseline();
+  }
+  notify_run_finished();
+}
+
+void Orchestrator::run_test(const TestRegistration &registration, Test &test)
+{
+  TUNIT_SCOPED_TRACE("running test: " + registration.suite_name_ + "::" + registration.test_name_);
+  const bool observed = has_listeners_.load(std::memory_order_relaxed);
+  if (observed)
+  {
+    notify_test_started(test);
+  }
+  const utils::PerfCounts counters_start = utils::thread_perf_counts();
+  const utils::CpuTime cpu_start = utils::thread_cpu_time();
+  const auto start = std::chrono::steady_clock::now();
+
+  // Set by whichever comes first, the end of the body or the deadline; the loser stands down
+  std::atomic<bool> finished{false};
+  std::uint64_t alarm = 0;
+  const double timeout = watchdog_ != nullptr ? timeout_for(registration) : 0;
+  if (timeout > 0)
+  {
+    const trace::TraceStack &stack = trace::TraceContext::this_thread();
+    alarm = watchdog_->arm(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeout)),
+                           [this, &test, &finished, &stack, timeout, start]()
+                           { on_timeout(test, finished, stack, timeout, start); });
+  }
+
+  {
+    utils::AllocationScope allocations;
+    // An escaping exception fails the test instead of aborting the run
+    try
+    {
+      registration.body_(test);
+    }
+    catch (const std::exception &e)
+    {
+      test.expect(std::string("uncaught exception: ") + e.what(), false);
+    }
+    catch (...)
+    {
+      test.expect("uncaught exception of unknown type", false);
+    }
+    test.timing_.allocations_ = allocations.stats();
+  }
+  if (alarm != 0)
+  {
+    // If the deadline won, cancel blocks until on_timeout ends the process; otherwise it waits
+    // out a callback about to stand down, which still references this frame and thread
+    finished.store(true);
+    watchdog_->cancel(alarm);
+  }
+
+  test.timing_.wall_ = std::chrono::steady_clock::now() - start;
+  const utils::CpuTime cpu_end = utils::thread_cpu_time();
+  test.timing_.user_ = cpu_end.user_ - cpu_start.user_;
+  test.timing_.system_ = cpu_end.system_ - cpu_start.system_;
+  test.timing_.counters_ = utils::thread_perf_counts() - counters_start;
+
+  // Opt-in: function-local statics and library caches filled by a test are still live at its end
+  const utils::AllocationStats &heap = test.timing_.allocations_;
+  if (heap.leaked_bytes() > 0 && (fail_leaks_ || (registration.tags_ & leak_tag_).any()))
+  {
+    test.expect("leaked " + std::to_string(heap.leaked_bytes()) + " bytes (still allocated at test end; " + std::to_string(heap.allocations_) +
+                    " allocation(s), peak " + std::to_string(heap.peak_live_bytes_) + " bytes live)",
+                false);
+  }
+  if (observed)
+  {
+    notify_test_finished(test);
+  }
+}
+
+double Orchestrator::timeout_for(const TestRegistration &registration) const
+{
+  return registration.timeout_ > 0 ? registration.timeout_ : test_timeout_;
+}
+
+bool Orchestrator::has_timeouts(const std::vector<size_t> &selected) const
+{
+  return test_timeout_ > 0 || std::any_of(selected.begin(), selected.end(), [this](size_t index)
+                                          { return registrations_[index].timeout_ > 0; });
+}
+
+void Orchestrator::on_timeout(Test &test, std::atomic<bool> &finished, const trace::TraceStack &stack, double seconds,
+                              std::chrono::steady_clock::time_point started)
+{
+  if (finished.exchange(true))
+  {
+    return; // the body ended right at the deadline
+  }
+  std::ostringstream reason;
+  reason << "test timed out after " << seconds << "s";
+  const std::string trace = trace::TraceContext::get_trace_output(stack);
+  std::cerr << "\n"
+            << test.suite_name() << "::" << test.name() << ": " << reason.str() << "\n"
+            << trace << std::flush;
+
+  // A worker just exits; the parent fails the test and starts a replacement
+  if (!worker_process_)
+  {
+    // The stuck thread cannot be stopped, so this process ends here. Finished tests are already
+    // in the streaming reports (-C, --results, --reporter); add this one, write the -C report,
+    // summarize and stop.
+    // The stuck thread may itself hold a lock (hung in a listener callback or a registration),
+    // so only what is free within a short wait is used and _Exit is always reached.
+    const auto elapsed = std::chrono::steady_clock::now() - started;
+    const auto patience = std::chrono::seconds(2);
+    const bool registry_free = free_within(registry_mutex_, patience);
+    if (!free_within(listener_mutex_, patience))
+    {
+      has_listeners_.store(false, std::memory_order_relaxed);
+      has_assertion_listeners_.store(false, std::memory_order_relaxed);
+      std::cerr << "Reporters are held by the stuck test; their output ends before it" << std::endl;
+    }
+    if (registry_free)
+    {
+      test.timing_.wall_ = elapsed;
+      log_assertion(*test.results_, reason.str() + (trace.empty() ? "" : "\n" + trace), false);
+      if (has_listeners_.load(std::memory_order_relaxed))
+      {
+        notify_test_finished(test);
+      }
+      // The final -C report, grouped by suite, as run_finished would have written it
+      if (!xml_output_path_.empty())
+      {
+        write_junit(xml_output_path());
+      }
+      print_summary();
+    }
+    else
+    {
+      std::cerr << "The test registry is held by the stuck test; no summary can be collected" << std::endl;
+    }
+    std::cerr << "Stopping the run: results so far are flushed; use --isolate to fail hung tests and continue" << std::endl;
+  }
+  std::cout.flush();
+  std::fflush(nullptr);
+  std::_Exit(exit_timed_out);
+}
+
+} // namespace tUnit
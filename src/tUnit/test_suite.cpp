@@ -10,17 +10,10 @@ Suite::Suite(const std::string &name) : name_(name)
   TUNIT_SCOPED_TRACE("registering suite: " + name_);
 }
 
-Test &Suite::get_test(const std::string &test_name)
+Test &Suite::get_test(std::string_view test_name)
 {
-  auto it = tests_.find(test_name);
-  if (it != tests_.end())
-  {
-    return *(it->second);
-  }
-
-  Test &test = Orchestrator::instance().get_test(name_, test_name);
-  tests_[test_name] = &test;
-  return test;
+  // tests_ is shared with other threads, so lookups and registration go through the Orchestrator's lock
+  return Orchestrator::instance().get_test(*this, test_name);
 }
 
 const std::string &Suite::name() const
@@ -28,4 +21,15 @@ const std::string &Suite::name() const
   return name_;
 }
 
+const std::vector<Test *> &Suite::test_order() const
+{
+  return test_order_;
+}
+
+const ResultCounters &Suite::counters() const
+{
+  Orchestrator::instance().collect();
+  return counters_;
+}
+
 } // namespace tUnit
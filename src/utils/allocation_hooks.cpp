@@ -0,0 +1,111 @@
+/**
+ * Replacement global operator new/delete that report to the allocation tracker
+ *
+ * Built as the tunit_alloc object library: add its objects to a test binary to enable
+ * per-test allocation accounting, leak failures and Test::expect_no_allocations. Every block
+ * carries a 16-byte header with its owner tag and requested size, so a free is credited to
+ * the scope that allocated it, whichever thread frees it.
+ */
+#include "utils/allocation_tracker.h"
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+using tUnit::utils::allocation_tracking::record_allocation;
+using tUnit::utils::allocation_tracking::record_free;
+
+[[maybe_unused]] const bool registered = (tUnit::utils::allocation_tracking::mark_available(), true);
+
+struct Header
+{
+  std::uint64_t owner_;
+  std::uint64_t size_;
+};
+static_assert(sizeof(Header) == 16 && alignof(std::max_align_t) <= 16, "the header must keep malloc's alignment");
+
+// Distance from the start of the underlying block to the pointer handed out
+std::size_t header_offset(std::size_t alignment) noexcept
+{
+  return alignment > sizeof(Header) ? alignment : sizeof(Header);
+}
+
+void *allocate(std::size_t size, std::size_t alignment) noexcept
+{
+  const std::size_t offset = header_offset(alignment);
+  if (size > SIZE_MAX - offset)
+  {
+    return nullptr;
+  }
+  for (;;)
+  {
+    void *block = nullptr;
+    if (alignment <= alignof(std::max_align_t))
+    {
+      block = std::malloc(size + offset);
+    }
+    else if (::posix_memalign(&block, alignment, size + offset) != 0)
+    {
+      block = nullptr;
+    }
+    if (block != nullptr)
+    {
+      char *memory = static_cast<char *>(block) + offset;
+      ::new (memory - sizeof(Header)) Header{record_allocation(size), size};
+      return memory;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr)
+    {
+      return nullptr;
+    }
+    handler(); // may throw bad_alloc itself
+  }
+}
+
+void *allocate_or_throw(std::size_t size, std::size_t alignment)
+{
+  void *memory = allocate(size, alignment);
+  if (memory == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void release(void *memory, std::size_t alignment = 0) noexcept
+{
+  if (memory != nullptr)
+  {
+    char *bytes = static_cast<char *>(memory);
+    const Header *header = reinterpret_cast<const Header *>(bytes - sizeof(Header));
+    record_free(header->owner_, header->size_);
+    std::free(bytes - header_offset(alignment));
+  }
+}
+
+} // anonymous namespace
+
+void *operator new(std::size_t size) { return allocate_or_throw(size, 0); }
+void *operator new[](std::size_t size) { return allocate_or_throw(size, 0); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return allocate(size, 0); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return allocate(size, 0); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return allocate_or_throw(size, static_cast<std::size_t>(alignment)); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return allocate_or_throw(size, static_cast<std::size_t>(alignment)); }
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return allocate(size, static_cast<std::size_t>(alignment)); }
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return allocate(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void *memory) noexcept { release(memory); }
+void operator delete[](void *memory) noexcept { release(memory); }
+void operator delete(void *memory, std::size_t) noexcept { release(memory); }
+void operator delete[](void *memory, std::size_t) noexcept { release(memory); }
+void operator delete(void *memory, const std::nothrow_t &) noexcept { release(memory); }
+void operator delete[](void *memory, const std::nothrow_t &) noexcept { release(memory); }
+void operator delete(void *memory, std::align_val_t alignment) noexcept { release(memory, static_cast<std::size_t>(alignment)); }
+void operator delete[](void *memory, std::align_val_t alignment) noexcept { release(memory, static_cast<std::size_t>(alignment)); }
+void operator delete(void *memory, std::size_t, std::align_val_t alignment) noexcept { release(memory, static_cast<std::size_t>(alignment)); }
+void operator delete[](void *memory, std::size_t, std::align_val_t alignment) noexcept { release(memory, static_cast<std::size_t>(alignment)); }
+void operator delete(void *memory, std::align_val_t alignment, const std::nothrow_t &) noexcept { release(memory, static_cast<std::size_t>(alignment)); }
+void operator delete[](void *memory, std::align_val_t alignment, const std::nothrow_t &) noexcept { release(memory, static_cast<std::size_t>(alignment)); }
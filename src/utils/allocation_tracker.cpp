@@ -0,0 +1,159 @@
+#include "utils/allocation_tracker.h"
+#include <algorithm>
+#include <atomic>
+
+namespace tUnit
+{
+namespace utils
+{
+
+namespace
+{
+
+bool hooks_linked = false;
+
+// Outermost scopes that are still open; frees from other threads land in the owner's slot.
+// A tag is a sequence number with the slot index in its low byte, so it is never below 256.
+struct OwnerSlot
+{
+  std::atomic<std::uint64_t> owner_{0}; // 0: free, 1: being claimed
+  std::atomic<std::int64_t> freed_elsewhere_{0};
+};
+constexpr std::size_t owner_slots = 256;
+OwnerSlot slots[owner_slots];
+std::atomic<std::uint64_t> next_owner{1};
+
+// A tag naming a free slot; with more open outermost scopes than slots, one naming a slot it
+// does not hold, so frees on other threads are not credited but local ones still are
+std::uint64_t claim_owner() noexcept
+{
+  const std::uint64_t sequence = next_owner.fetch_add(1, std::memory_order_relaxed);
+  for (std::size_t i = 0; i < owner_slots; ++i)
+  {
+    const std::size_t index = (sequence + i) % owner_slots;
+    std::uint64_t expected = 0;
+    if (slots[index].owner_.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+    {
+      const std::uint64_t tag = (sequence << 8) | index;
+      slots[index].freed_elsewhere_.store(0, std::memory_order_relaxed);
+      slots[index].owner_.store(tag, std::memory_order_release);
+      return tag;
+    }
+  }
+  return sequence << 8;
+}
+
+bool holds_slot(std::uint64_t owner) noexcept
+{
+  return slots[owner & 0xff].owner_.load(std::memory_order_acquire) == owner;
+}
+
+// Plain pointers and ints: usable from the hooks at any point in a thread's life
+thread_local AllocationStats *active = nullptr;
+thread_local std::uint64_t active_owner = 0;
+thread_local int paused = 0;
+
+} // anonymous namespace
+
+namespace allocation_tracking
+{
+
+std::uint64_t record_allocation(std::size_t size) noexcept
+{
+  AllocationStats *stats = active;
+  if (stats == nullptr || paused != 0)
+  {
+    return 0;
+  }
+  ++stats->allocations_;
+  stats->bytes_ += size;
+  stats->live_bytes_ += static_cast<std::int64_t>(size);
+  stats->peak_live_bytes_ = std::max(stats->peak_live_bytes_, stats->live_bytes_);
+  return active_owner;
+}
+
+void record_free(std::uint64_t owner, std::size_t size) noexcept
+{
+  if (owner == 0)
+  {
+    return;
+  }
+  if (owner == active_owner && active != nullptr)
+  {
+    active->live_bytes_ -= static_cast<std::int64_t>(size);
+    return;
+  }
+  // Another thread's scope, or one already closed (then the slot has moved on and this is ignored)
+  if (holds_slot(owner))
+  {
+    slots[owner & 0xff].freed_elsewhere_.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed);
+  }
+}
+
+void mark_available() noexcept
+{
+  hooks_linked = true;
+}
+
+bool available() noexcept
+{
+  return hooks_linked;
+}
+
+} // namespace allocation_tracking
+
+AllocationScope::AllocationScope() noexcept : outer_(active)
+{
+  stats_.tracked_ = hooks_linked;
+  if (outer_ == nullptr && hooks_linked)
+  {
+    owner_ = claim_owner();
+    active_owner = owner_;
+  }
+  active = &stats_;
+}
+
+AllocationScope::~AllocationScope()
+{
+  active = outer_;
+  if (owner_ != 0)
+  {
+    active_owner = 0;
+    if (holds_slot(owner_))
+    {
+      OwnerSlot &slot = slots[owner_ & 0xff];
+      slot.owner_.store(0, std::memory_order_release);
+      stats_.live_bytes_ -= slot.freed_elsewhere_.load(std::memory_order_relaxed);
+    }
+  }
+  if (outer_ != nullptr)
+  {
+    outer_->allocations_ += stats_.allocations_;
+    outer_->bytes_ += stats_.bytes_;
+    outer_->peak_live_bytes_ = std::max(outer_->peak_live_bytes_, outer_->live_bytes_ + stats_.peak_live_bytes_);
+    outer_->live_bytes_ += stats_.live_bytes_;
+  }
+}
+
+const AllocationStats &AllocationScope::stats()
+{
+  if (owner_ != 0 && holds_slot(owner_))
+  {
+    // Credit what other threads have freed so far
+    stats_.live_bytes_ -= slots[owner_ & 0xff].freed_elsewhere_.exchange(0, std::memory_order_relaxed);
+  }
+  return stats_;
+}
+
+AllocationPause::AllocationPause() noexcept
+{
+  ++paused;
+}
+
+AllocationPause::~AllocationPause()
+{
+  --paused;
+}
+
+} // namespace utils
+} // namespace tUnit
@@ -0,0 +1,49 @@
+#include "utils/mapped_file.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tUnit
+{
+namespace utils
+{
+
+MappedFile::MappedFile(const std::string &path)
+{
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return;
+  }
+
+  struct stat info{};
+  if (::fstat(fd, &info) == 0)
+  {
+    size_ = static_cast<std::size_t>(info.st_size);
+    opened_ = true;
+    // mmap rejects zero-length mappings; an empty file is simply empty
+    if (size_ > 0)
+    {
+      data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data_ == MAP_FAILED)
+      {
+        data_ = nullptr;
+        size_ = 0;
+        opened_ = false;
+      }
+    }
+  }
+  ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_ != nullptr)
+  {
+    ::munmap(data_, size_);
+  }
+}
+
+} // namespace utils
+} // namespace tUnit
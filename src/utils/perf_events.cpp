@@ -0,0 +1,224 @@
+#include "utils/perf_events.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tUnit
+{
+namespace utils
+{
+
+namespace
+{
+
+std::atomic<bool> enabled{false};
+
+#ifdef __linux__
+
+struct EventSpec
+{
+  std::uint32_t type_;
+  std::uint64_t config_;
+};
+
+constexpr std::uint64_t cache_miss(std::uint64_t cache)
+{
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+// Indexed by PerfCounts::Event
+constexpr EventSpec specs[PerfCounts::event_count] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+
+/**
+ * One group per thread, so all events are scheduled (and multiplexed) together and one
+ * read() returns them all
+ */
+class CounterGroup
+{
+public:
+  CounterGroup()
+  {
+    for (int event = 0; event < PerfCounts::event_count; ++event)
+    {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = specs[event].type_;
+      attr.config = specs[event].config_;
+      attr.exclude_kernel = 1; // allowed at perf_event_paranoid 2
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.disabled = leader_ < 0; // the leader starts the whole group
+      // pid 0, cpu -1: the calling thread on any CPU
+      const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, leader_, PERF_FLAG_FD_CLOEXEC));
+      if (fd < 0)
+      {
+        continue;
+      }
+      if (leader_ < 0)
+      {
+        leader_ = fd;
+      }
+      else
+      {
+        members_[count_ - 1] = fd;
+      }
+      order_[count_++] = static_cast<PerfCounts::Event>(event);
+      available_ |= 1u << event;
+    }
+    if (leader_ >= 0)
+    {
+      ::ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    warn_once(available_);
+  }
+
+  ~CounterGroup()
+  {
+    for (int i = 0; i + 1 < count_; ++i)
+    {
+      ::close(members_[i]);
+    }
+    if (leader_ >= 0)
+    {
+      ::close(leader_);
+    }
+  }
+
+  CounterGroup(const CounterGroup &) = delete;
+  CounterGroup &operator=(const CounterGroup &) = delete;
+
+  PerfCounts read() const
+  {
+    PerfCounts counts;
+    // { nr, time_enabled, time_running, value[nr] }
+    std::uint64_t data[3 + PerfCounts::event_count];
+    if (leader_ < 0 || ::read(leader_, data, sizeof(data)) < static_cast<ssize_t>(3 * sizeof(std::uint64_t)))
+    {
+      return counts;
+    }
+    const std::uint64_t enabled_ns = data[1];
+    const std::uint64_t running_ns = data[2];
+    if (running_ns == 0)
+    {
+      return counts; // never got a hardware slot
+    }
+    // Scale up when the kernel multiplexed the group with other users of the PMU
+    const double scale = static_cast<double>(enabled_ns) / static_cast<double>(running_ns);
+    for (std::uint64_t i = 0; i < data[0] && i < static_cast<std::uint64_t>(count_); ++i)
+    {
+      counts.values_[order_[i]] = running_ns == enabled_ns ? data[3 + i] : static_cast<std::uint64_t>(static_cast<double>(data[3 + i]) * scale);
+    }
+    counts.available_ = available_;
+    return counts;
+  }
+
+private:
+  static void warn_once(std::uint32_t available)
+  {
+    constexpr std::uint32_t hardware = (1u << PerfCounts::page_faults) - 1;
+    if ((available & hardware) == hardware)
+    {
+      return;
+    }
+    static std::once_flag warned;
+    std::call_once(warned, [available]()
+                   {
+      int paranoid = -1;
+      std::ifstream("/proc/sys/kernel/perf_event_paranoid") >> paranoid;
+      std::string counting;
+      for (int event = 0; event < PerfCounts::event_count; ++event)
+      {
+        if ((available >> event) & 1u)
+        {
+          counting.append(counting.empty() ? "" : ", ").append(PerfCounts::names[event]);
+        }
+      }
+      std::cerr << "Note: some hardware performance counters are unavailable (no PMU, or perf_event_paranoid=" << paranoid
+                << "); counting: " << (counting.empty() ? "nothing" : counting) << std::endl; });
+  }
+
+  int leader_ = -1;
+  int members_[PerfCounts::event_count - 1] = {};
+  PerfCounts::Event order_[PerfCounts::event_count] = {};
+  int count_ = 0;
+  std::uint32_t available_ = 0;
+};
+
+#endif
+
+} // anonymous namespace
+
+PerfCounts operator-(const PerfCounts &end, const PerfCounts &start)
+{
+  PerfCounts delta;
+  delta.available_ = end.available_ & start.available_;
+  for (int event = 0; event < PerfCounts::event_count; ++event)
+  {
+    delta.values_[event] = delta.has(static_cast<PerfCounts::Event>(event)) ? end.values_[event] - start.values_[event] : 0;
+  }
+  return delta;
+}
+
+void enable_perf_counters()
+{
+  enabled.store(true, std::memory_order_relaxed);
+}
+
+bool perf_counters_enabled()
+{
+  return enabled.load(std::memory_order_relaxed);
+}
+
+PerfCounts thread_perf_counts()
+{
+  if (!enabled.load(std::memory_order_relaxed))
+  {
+    return {};
+  }
+#ifdef __linux__
+  thread_local const CounterGroup group;
+  return group.read();
+#else
+  return {};
+#endif
+}
+
+std::string format_counts(const PerfCounts &counts, double per)
+{
+  std::string out;
+  char value[64];
+  for (int event = 0; event < PerfCounts::event_count; ++event)
+  {
+    if (!counts.has(static_cast<PerfCounts::Event>(event)))
+    {
+      continue;
+    }
+    std::snprintf(value, sizeof(value), " %.3g", static_cast<double>(counts.values_[event]) / per);
+    out.append(out.empty() ? "" : ", ").append(PerfCounts::names[event]).append(value);
+    if (event == PerfCounts::instructions && counts.has(PerfCounts::cycles) && counts[PerfCounts::cycles] > 0)
+    {
+      std::snprintf(value, sizeof(value), " (IPC %.2f)", static_cast<double>(counts[PerfCounts::instructions]) / static_cast<double>(counts[PerfCounts::cycles]));
+      out += value;
+    }
+  }
+  return out;
+}
+
+} // namespace utils
+} // namespace tUnit
@@ -0,0 +1,323 @@
+#include "utils/simd_kernels.h"
+#include <cstring>
+
+namespace tUnit
+{
+namespace utils
+{
+namespace simd
+{
+
+namespace
+{
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TUNIT_SIMD_X86 1
+#define TUNIT_SIMD_TARGET(isa) __attribute__((target(isa), flatten))
+#else
+#define TUNIT_SIMD_X86 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TUNIT_SIMD_INLINE __attribute__((always_inline)) inline
+#else
+#define TUNIT_SIMD_INLINE inline
+#endif
+
+// Elements per block: blocks are checked without branches (so they vectorize), and the scan
+// only stops at the first block containing a match
+constexpr std::size_t block = 64;
+
+template <typename F>
+TUNIT_SIMD_INLINE std::size_t first_index(std::size_t n, F at)
+{
+  std::size_t i = 0;
+  for (; i + block <= n; i += block)
+  {
+    unsigned hits = 0;
+    for (std::size_t j = 0; j < block; ++j)
+    {
+      hits |= at(i + j) ? 1u : 0u;
+    }
+    if (hits != 0)
+    {
+      break;
+    }
+  }
+  for (; i < n; ++i)
+  {
+    if (at(i))
+    {
+      return i;
+    }
+  }
+  return n;
+}
+
+// The exact comparisons of the numeric predicates; for integers x % 2 == 0 is (x & 1) == 0
+template <ElementTest Test, typename T>
+TUNIT_SIMD_INLINE bool passes(T value)
+{
+  if constexpr (Test == ElementTest::positive)
+  {
+    return value > T{};
+  }
+  else if constexpr (Test == ElementTest::negative)
+  {
+    return value < T{};
+  }
+  else if constexpr (Test == ElementTest::zero)
+  {
+    return value == T{};
+  }
+  else if constexpr (std::is_integral_v<T>)
+  {
+    return ((value & 1) == 0) == (Test == ElementTest::even);
+  }
+  else
+  {
+    return false; // even/odd are never requested for floating point
+  }
+}
+
+template <typename T>
+TUNIT_SIMD_INLINE std::size_t find_impl(const T *data, std::size_t n, T value)
+{
+  return first_index(n, [&](std::size_t i) { return data[i] == value; });
+}
+
+template <typename T>
+TUNIT_SIMD_INLINE bool is_sorted_impl(const T *data, std::size_t n, bool descending)
+{
+  if (n < 2)
+  {
+    return true;
+  }
+  const T *next = data + 1;
+  if (descending)
+  {
+    return first_index(n - 1, [&](std::size_t i) { return next[i] > data[i]; }) == n - 1;
+  }
+  return first_index(n - 1, [&](std::size_t i) { return next[i] < data[i]; }) == n - 1;
+}
+
+template <typename T>
+TUNIT_SIMD_INLINE bool equal_impl(const T *lhs, const T *rhs, std::size_t n)
+{
+  return first_index(n, [&](std::size_t i) { return !(lhs[i] == rhs[i]); }) == n;
+}
+
+template <ElementTest Test, typename T>
+TUNIT_SIMD_INLINE std::size_t count_impl(const T *data, std::size_t n)
+{
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    total += passes<Test>(data[i]) ? 1 : 0;
+  }
+  return total;
+}
+
+template <typename T>
+TUNIT_SIMD_INLINE std::size_t count_impl(const T *data, std::size_t n, ElementTest test)
+{
+  switch (test)
+  {
+  case ElementTest::positive:
+    return count_impl<ElementTest::positive>(data, n);
+  case ElementTest::negative:
+    return count_impl<ElementTest::negative>(data, n);
+  case ElementTest::zero:
+    return count_impl<ElementTest::zero>(data, n);
+  case ElementTest::even:
+    return count_impl<ElementTest::even>(data, n);
+  case ElementTest::odd:
+    return count_impl<ElementTest::odd>(data, n);
+  }
+  return 0;
+}
+
+template <ElementTest Test, typename T>
+TUNIT_SIMD_INLINE std::size_t find_test_impl(const T *data, std::size_t n, bool expected)
+{
+  return first_index(n, [&](std::size_t i) { return passes<Test>(data[i]) == expected; });
+}
+
+template <typename T>
+TUNIT_SIMD_INLINE std::size_t find_test_impl(const T *data, std::size_t n, ElementTest test, bool expected)
+{
+  switch (test)
+  {
+  case ElementTest::positive:
+    return find_test_impl<ElementTest::positive>(data, n, expected);
+  case ElementTest::negative:
+    return find_test_impl<ElementTest::negative>(data, n, expected);
+  case ElementTest::zero:
+    return find_test_impl<ElementTest::zero>(data, n, expected);
+  case ElementTest::even:
+    return find_test_impl<ElementTest::even>(data, n, expected);
+  case ElementTest::odd:
+    return find_test_impl<ElementTest::odd>(data, n, expected);
+  }
+  return n;
+}
+
+/**
+ * One instruction set's entry points; the bodies above are inlined into each, so the compiler
+ * vectorizes them for that target
+ */
+template <typename T>
+struct Kernels
+{
+  std::size_t (*find_)(const T *, std::size_t, T);
+  bool (*is_sorted_)(const T *, std::size_t, bool);
+  bool (*equal_)(const T *, const T *, std::size_t);
+  std::size_t (*count_)(const T *, std::size_t, ElementTest);
+  std::size_t (*find_test_)(const T *, std::size_t, ElementTest, bool);
+};
+
+#define TUNIT_SIMD_ENTRY_POINTS(suffix, attributes)                                                                                   \
+  template <typename T>                                                                                                              \
+  attributes std::size_t find_##suffix(const T *data, std::size_t n, T value) { return find_impl(data, n, value); }                   \
+  template <typename T>                                                                                                              \
+  attributes bool is_sorted_##suffix(const T *data, std::size_t n, bool descending) { return is_sorted_impl(data, n, descending); }   \
+  template <typename T>                                                                                                              \
+  attributes bool equal_##suffix(const T *lhs, const T *rhs, std::size_t n) { return equal_impl(lhs, rhs, n); }                       \
+  template <typename T>                                                                                                              \
+  attributes std::size_t count_##suffix(const T *data, std::size_t n, ElementTest test) { return count_impl(data, n, test); }         \
+  template <typename T>                                                                                                              \
+  attributes std::size_t find_test_##suffix(const T *data, std::size_t n, ElementTest test, bool expected)                           \
+  {                                                                                                                                  \
+    return find_test_impl(data, n, test, expected);                                                                                  \
+  }                                                                                                                                  \
+  template <typename T>                                                                                                              \
+  constexpr Kernels<T> kernels_##suffix = {&find_##suffix<T>, &is_sorted_##suffix<T>, &equal_##suffix<T>, &count_##suffix<T>,      \
+                                           &find_test_##suffix<T>};
+
+TUNIT_SIMD_ENTRY_POINTS(baseline, )
+#if TUNIT_SIMD_X86
+TUNIT_SIMD_ENTRY_POINTS(avx2, TUNIT_SIMD_TARGET("avx2"))
+TUNIT_SIMD_ENTRY_POINTS(avx512, TUNIT_SIMD_TARGET("avx512f,avx512bw,avx512vl"))
+#endif
+
+Level detect_level()
+{
+#if TUNIT_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+  {
+    return Level::avx512;
+  }
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return Level::avx2;
+  }
+#endif
+  return Level::baseline;
+}
+
+// A level the CPU lacks falls back to the best one it has
+template <typename T>
+const Kernels<T> &kernels(Level level)
+{
+#if TUNIT_SIMD_X86
+  if (level > best_level())
+  {
+    level = best_level();
+  }
+  switch (level)
+  {
+  case Level::avx512:
+    return kernels_avx512<T>;
+  case Level::avx2:
+    return kernels_avx2<T>;
+  case Level::baseline:
+    break;
+  }
+#else
+  (void)level;
+#endif
+  return kernels_baseline<T>;
+}
+
+} // anonymous namespace
+
+Level best_level()
+{
+  static const Level level = detect_level();
+  return level;
+}
+
+const char *level_name(Level level)
+{
+  switch (level)
+  {
+  case Level::avx512:
+    return "avx512";
+  case Level::avx2:
+    return "avx2";
+  case Level::baseline:
+    break;
+  }
+  return TUNIT_SIMD_X86 ? "sse2" : "baseline";
+}
+
+template <typename T>
+std::size_t find(const T *data, std::size_t n, T value, Level level)
+{
+  return kernels<T>(level).find_(data, n, value);
+}
+
+template <typename T>
+bool is_sorted(const T *data, std::size_t n, bool descending, Level level)
+{
+  return kernels<T>(level).is_sorted_(data, n, descending);
+}
+
+template <typename T>
+bool equal(const T *lhs, const T *rhs, std::size_t n, Level level)
+{
+  if constexpr (std::is_integral_v<T>)
+  {
+    // Integers are equal exactly when their bytes are, and libc's memcmp is already vectorized
+    return n == 0 || std::memcmp(lhs, rhs, n * sizeof(T)) == 0;
+  }
+  return kernels<T>(level).equal_(lhs, rhs, n);
+}
+
+template <typename T>
+std::size_t count(const T *data, std::size_t n, ElementTest test, Level level)
+{
+  return kernels<T>(level).count_(data, n, test);
+}
+
+template <typename T>
+std::size_t find_test(const T *data, std::size_t n, ElementTest test, bool expected, Level level)
+{
+  return kernels<T>(level).find_test_(data, n, test, expected);
+}
+
+#define TUNIT_SIMD_INSTANTIATE(T)                                                         \
+  template std::size_t find<T>(const T *, std::size_t, T, Level);                         \
+  template bool is_sorted<T>(const T *, std::size_t, bool, Level);                        \
+  template bool equal<T>(const T *, const T *, std::size_t, Level);                       \
+  template std::size_t count<T>(const T *, std::size_t, ElementTest, Level);              \
+  template std::size_t find_test<T>(const T *, std::size_t, ElementTest, bool, Level);
+
+TUNIT_SIMD_INSTANTIATE(char)
+TUNIT_SIMD_INSTANTIATE(signed char)
+TUNIT_SIMD_INSTANTIATE(unsigned char)
+TUNIT_SIMD_INSTANTIATE(short)
+TUNIT_SIMD_INSTANTIATE(unsigned short)
+TUNIT_SIMD_INSTANTIATE(int)
+TUNIT_SIMD_INSTANTIATE(unsigned int)
+TUNIT_SIMD_INSTANTIATE(long)
+TUNIT_SIMD_INSTANTIATE(unsigned long)
+TUNIT_SIMD_INSTANTIATE(long long)
+TUNIT_SIMD_INSTANTIATE(unsigned long long)
+TUNIT_SIMD_INSTANTIATE(float)
+TUNIT_SIMD_INSTANTIATE(double)
+
+} // namespace simd
+} // namespace utils
+} // namespace tUnit
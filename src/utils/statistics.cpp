@@ -0,0 +1,122 @@
+#include "utils/statistics.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace tUnit
+{
+namespace utils
+{
+
+namespace
+{
+
+// Exact null distribution of U for sizes m and n: counts[u] = arrangements giving U = u
+std::vector<double> u_distribution(size_t m, size_t n)
+{
+  // table[i][j] is the distribution for sizes (i, j); c(i, j, u) = c(i - 1, j, u - j) + c(i, j - 1, u)
+  std::vector<std::vector<std::vector<double>>> table(m + 1, std::vector<std::vector<double>>(n + 1));
+  for (size_t i = 0; i <= m; ++i)
+  {
+    for (size_t j = 0; j <= n; ++j)
+    {
+      std::vector<double> &counts = table[i][j];
+      counts.assign(i * j + 1, 0.0);
+      if (i == 0 || j == 0)
+      {
+        counts[0] = 1;
+        continue;
+      }
+      const std::vector<double> &fewer_candidates = table[i - 1][j];
+      const std::vector<double> &fewer_baseline = table[i][j - 1];
+      for (size_t u = 0; u < counts.size(); ++u)
+      {
+        counts[u] = (u >= j && u - j < fewer_candidates.size() ? fewer_candidates[u - j] : 0.0) +
+                    (u < fewer_baseline.size() ? fewer_baseline[u] : 0.0);
+      }
+    }
+  }
+  return table[m][n];
+}
+
+constexpr size_t exact_limit = 20;
+
+} // anonymous namespace
+
+double mann_whitney_greater_p(const std::vector<double> &baseline, const std::vector<double> &candidate)
+{
+  const size_t n = baseline.size();
+  const size_t m = candidate.size();
+  if (n == 0 || m == 0)
+  {
+    return 1.0;
+  }
+
+  // U counts the (candidate, baseline) pairs where the candidate is larger; ties count half
+  double u = 0;
+  for (double c : candidate)
+  {
+    for (double b : baseline)
+    {
+      u += c > b ? 1.0 : c == b ? 0.5 : 0.0;
+    }
+  }
+
+  std::map<double, size_t> ties;
+  for (double v : baseline)
+  {
+    ++ties[v];
+  }
+  for (double v : candidate)
+  {
+    ++ties[v];
+  }
+  const bool tied = ties.size() < n + m;
+
+  if (!tied && m <= exact_limit && n <= exact_limit)
+  {
+    const std::vector<double> counts = u_distribution(m, n);
+    double at_least = 0;
+    double total = 0;
+    for (size_t k = 0; k < counts.size(); ++k)
+    {
+      total += counts[k];
+      at_least += static_cast<double>(k) >= u ? counts[k] : 0.0;
+    }
+    return at_least / total;
+  }
+
+  const double size = static_cast<double>(n + m);
+  double tie_term = 0;
+  for (const auto &[value, count] : ties)
+  {
+    const double t = static_cast<double>(count);
+    tie_term += t * t * t - t;
+  }
+  const double mn = static_cast<double>(m * n);
+  const double variance = mn / 12.0 * ((size + 1) - tie_term / (size * (size - 1)));
+  if (variance <= 0)
+  {
+    return 1.0;
+  }
+  const double z = (u - mn / 2 - 0.5) / std::sqrt(variance);
+  return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+double median(std::vector<double> values)
+{
+  if (values.empty())
+  {
+    return 0;
+  }
+  const size_t mid = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + mid, values.end());
+  if (values.size() % 2 == 1)
+  {
+    return values[mid];
+  }
+  return (values[mid] + *std::max_element(values.begin(), values.begin() + mid)) / 2;
+}
+
+} // namespace utils
+} // namespace tUnit
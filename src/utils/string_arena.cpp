@@ -0,0 +1,109 @@
+#include "utils/string_arena.h"
+#include <cstring>
+
+namespace tUnit
+{
+namespace utils
+{
+
+std::string_view StringArena::store(std::string_view text)
+{
+  if (text.empty())
+  {
+    return {};
+  }
+
+  if (text.size() > remaining_)
+  {
+    // Oversized strings get a dedicated block so the current one keeps its free space
+    if (text.size() > block_size / 4)
+    {
+      blocks_.push_back(std::make_unique<char[]>(text.size()));
+      std::memcpy(blocks_.back().get(), text.data(), text.size());
+      bytes_used_ += text.size();
+      return {blocks_.back().get(), text.size()};
+    }
+
+    blocks_.push_back(std::make_unique<char[]>(block_size));
+    cursor_ = blocks_.back().get();
+    remaining_ = block_size;
+  }
+
+  char *destination = cursor_;
+  std::memcpy(destination, text.data(), text.size());
+  cursor_ += text.size();
+  remaining_ -= text.size();
+  bytes_used_ += text.size();
+  return {destination, text.size()};
+}
+
+StringInterner::Table::Table(std::size_t bucket_count) : mask_(bucket_count - 1), buckets_(new std::atomic<const Node *>[bucket_count]())
+{
+}
+
+StringInterner::StringInterner()
+{
+  tables_.push_back(std::make_unique<Table>(initial_buckets));
+  table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+const StringInterner::Node *StringInterner::find(const Table &table, std::string_view text, std::size_t hash)
+{
+  for (const Node *node = table.buckets_[hash & table.mask_].load(std::memory_order_acquire); node != nullptr; node = node->next_)
+  {
+    if (node->hash_ == hash && node->text_ == text)
+    {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+// Requires mutex_ when table is published
+void StringInterner::insert(Table &table, std::string_view text, std::size_t hash)
+{
+  std::atomic<const Node *> &head = table.buckets_[hash & table.mask_];
+  table.nodes_.push_back(Node{text, hash, head.load(std::memory_order_relaxed)});
+  head.store(&table.nodes_.back(), std::memory_order_release);
+}
+
+std::string_view StringInterner::intern(std::string_view text)
+{
+  const std::size_t hash = std::hash<std::string_view>{}(text);
+  if (const Node *node = find(*table_.load(std::memory_order_acquire), text, hash))
+  {
+    return node->text_;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  Table *table = tables_.back().get();
+  if (const Node *node = find(*table, text, hash))
+  {
+    return node->text_; // inserted since the lookup above, or that lookup saw an older table
+  }
+  if (table->nodes_.size() > table->mask_)
+  {
+    // Past one entry per bucket: rebuild at twice the size and publish once it is complete
+    auto grown = std::make_unique<Table>(2 * (table->mask_ + 1));
+    for (const Node &node : table->nodes_)
+    {
+      insert(*grown, node.text_, node.hash_);
+    }
+    tables_.push_back(std::move(grown));
+    table = tables_.back().get();
+    table_.store(table, std::memory_order_release);
+  }
+  const std::string_view stored = arena_.store(text);
+  insert(*table, stored, hash);
+  size_.fetch_add(1, std::memory_order_relaxed);
+  return stored;
+}
+
+std::size_t StringInterner::bytes_used() const
+{
+  std::lock_guard<std::mutex> guard(mutex_);
+  return arena_.bytes_used();
+}
+
+} // namespace utils
+} // namespace tUnit
@@ -5,7 +5,7 @@ namespace tUnit
 namespace trace
 {
 
-thread_local std::vector<TraceInfo> TraceContext::current_trace_;
+thread_local TraceStack TraceContext::current_trace_;
 
 } // namespace trace
 } // namespace tUnit
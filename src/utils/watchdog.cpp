@@ -0,0 +1,84 @@
+#include "utils/watchdog.h"
+
+namespace tUnit
+{
+namespace utils
+{
+
+Watchdog::Watchdog() : thread_([this]()
+                               { loop(); })
+{
+}
+
+Watchdog::~Watchdog()
+{
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+std::uint64_t Watchdog::arm(Clock::time_point deadline, std::function<void()> on_expiry)
+{
+  std::uint64_t id;
+  bool earliest;
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    id = next_id_++;
+    earliest = heap_.empty() || deadline < heap_.top().deadline_;
+    heap_.push({deadline, id});
+    pending_.emplace(id, std::move(on_expiry));
+  }
+  if (earliest)
+  {
+    wake_.notify_one(); // otherwise the thread already wakes no later than this deadline
+  }
+  return id;
+}
+
+void Watchdog::cancel(std::uint64_t id)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  pending_.erase(id);
+  callback_done_.wait(lock, [this, id]()
+                      { return running_ != id; });
+}
+
+void Watchdog::loop()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_)
+  {
+    if (heap_.empty())
+    {
+      wake_.wait(lock);
+      continue;
+    }
+    const Timer next = heap_.top();
+    auto it = pending_.find(next.id_);
+    if (it == pending_.end())
+    {
+      heap_.pop(); // cancelled
+      continue;
+    }
+    if (Clock::now() < next.deadline_)
+    {
+      wake_.wait_until(lock, next.deadline_);
+      continue;
+    }
+    heap_.pop();
+    std::function<void()> on_expiry = std::move(it->second);
+    pending_.erase(it);
+    running_ = next.id_;
+    lock.unlock();
+    on_expiry();
+    lock.lock();
+    running_ = 0;
+    callback_done_.notify_all();
+  }
+}
+
+} // namespace utils
+} // namespace tUnit
@@ -0,0 +1,98 @@
+#include "utils/work_stealing_pool.h"
+#include <thread>
+
+namespace tUnit
+{
+namespace utils
+{
+
+WorkStealingPool::WorkStealingPool(std::size_t workers)
+{
+  if (workers == 0)
+  {
+    workers = 1;
+  }
+  queues_.reserve(workers);
+  for (std::size_t i = 0; i < workers; ++i)
+  {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+}
+
+std::optional<std::size_t> WorkStealingPool::pop(std::size_t worker)
+{
+  WorkQueue &queue = *queues_[worker];
+  std::lock_guard<std::mutex> guard(queue.mutex_);
+  if (queue.tasks_.empty())
+  {
+    return std::nullopt;
+  }
+  std::size_t index = queue.tasks_.front();
+  queue.tasks_.pop_front();
+  return index;
+}
+
+std::optional<std::size_t> WorkStealingPool::steal(std::size_t thief)
+{
+  // Tasks are never added once the batch starts, so one full sweep finding nothing means the batch is drained
+  for (std::size_t offset = 1; offset < queues_.size(); ++offset)
+  {
+    WorkQueue &victim = *queues_[(thief + offset) % queues_.size()];
+    std::lock_guard<std::mutex> guard(victim.mutex_);
+    if (!victim.tasks_.empty())
+    {
+      std::size_t index = victim.tasks_.back();
+      victim.tasks_.pop_back();
+      return index;
+    }
+  }
+  return std::nullopt;
+}
+
+void WorkStealingPool::run(std::size_t count, const std::function<void(std::size_t worker, std::size_t index)> &task)
+{
+  const std::size_t workers = queues_.size();
+  for (std::size_t worker = 0; worker < workers; ++worker)
+  {
+    std::size_t begin = count * worker / workers;
+    std::size_t end = count * (worker + 1) / workers;
+    auto &tasks = queues_[worker]->tasks_;
+    tasks.clear();
+    for (std::size_t index = begin; index < end; ++index)
+    {
+      tasks.push_back(index);
+    }
+  }
+
+  auto work = [this, &task](std::size_t worker)
+  {
+    while (true)
+    {
+      std::optional<std::size_t> index = pop(worker);
+      if (!index)
+      {
+        index = steal(worker);
+      }
+      if (!index)
+      {
+        return;
+      }
+      task(worker, *index);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (std::size_t worker = 1; worker < workers; ++worker)
+  {
+    threads.emplace_back(work, worker);
+  }
+  work(0); // the calling thread is worker 0
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+}
+
+} // namespace utils
+} // namespace tUnit
@@ -0,0 +1,198 @@
+#include "utils/xml_stream.h"
+#include <array>
+#include <cstring>
+
+namespace tUnit
+{
+namespace utils
+{
+
+namespace
+{
+
+using EscapeTable = std::array<const char *, 256>;
+
+// Replacement for every byte value; nullptr means the byte is copied unchanged
+constexpr EscapeTable make_escape_table(bool attribute)
+{
+  EscapeTable table{};
+  for (int c = 0; c < 0x20; ++c)
+  {
+    table[c] = "\xEF\xBF\xBD"; // U+FFFD: control characters are not allowed in XML 1.0
+  }
+  // Attribute-value normalization turns literal whitespace into spaces; references survive it
+  table['\t'] = attribute ? "&#9;" : nullptr;
+  table['\n'] = attribute ? "&#10;" : nullptr;
+  table['\r'] = "&#13;";
+  table['&'] = "&amp;";
+  table['<'] = "&lt;";
+  table['>'] = "&gt;";
+  table['"'] = "&quot;";
+  table['\''] = "&apos;";
+  return table;
+}
+
+constexpr EscapeTable text_table = make_escape_table(false);
+constexpr EscapeTable attribute_table = make_escape_table(true);
+
+// Length of the leading run of bytes that need no escaping
+size_t safe_prefix(const EscapeTable &table, std::string_view text)
+{
+  size_t i = 0;
+  while (i < text.size() && table[static_cast<unsigned char>(text[i])] == nullptr)
+  {
+    ++i;
+  }
+  return i;
+}
+
+} // anonymous namespace
+
+XmlStream::XmlStream(const std::string &path, size_t buffer_size) : file_(std::fopen(path.c_str(), "wb")), buffer_(buffer_size)
+{
+  if (file_ != nullptr)
+  {
+    std::setvbuf(file_, nullptr, _IONBF, 0); // buffer_ already batches the writes
+  }
+}
+
+XmlStream::~XmlStream()
+{
+  close();
+}
+
+XmlStream &XmlStream::raw(std::string_view text)
+{
+  put(text.data(), text.size());
+  return *this;
+}
+
+XmlStream &XmlStream::escaped(std::string_view text)
+{
+  return escaped(text, text_table);
+}
+
+XmlStream &XmlStream::attribute(std::string_view text)
+{
+  return escaped(text, attribute_table);
+}
+
+XmlStream &XmlStream::escaped(std::string_view text, const std::array<const char *, 256> &table)
+{
+  while (!text.empty())
+  {
+    size_t run = safe_prefix(table, text);
+    put(text.data(), run);
+    if (run == text.size())
+    {
+      break;
+    }
+    const char *replacement = table[static_cast<unsigned char>(text[run])];
+    put(replacement, std::strlen(replacement));
+    text.remove_prefix(run + 1);
+  }
+  return *this;
+}
+
+XmlStream &XmlStream::number(std::uint64_t value)
+{
+  char digits[20];
+  size_t n = 0;
+  do
+  {
+    digits[sizeof(digits) - 1 - n++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  put(digits + sizeof(digits) - n, n);
+  return *this;
+}
+
+XmlStream &XmlStream::seconds(std::chrono::nanoseconds duration)
+{
+  const auto micros = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+  number(micros / 1000000);
+  char fraction[8];
+  std::snprintf(fraction, sizeof(fraction), ".%06u", static_cast<unsigned>(micros % 1000000));
+  put(fraction, 7);
+  return *this;
+}
+
+XmlStream &XmlStream::decimal(double value)
+{
+  char text[32];
+  int size = std::snprintf(text, sizeof(text), "%.9g", value);
+  put(text, static_cast<size_t>(size));
+  return *this;
+}
+
+void XmlStream::escape_to(std::string &out, std::string_view text, bool attribute)
+{
+  const EscapeTable &table = attribute ? attribute_table : text_table;
+  while (!text.empty())
+  {
+    size_t run = safe_prefix(table, text);
+    out.append(text.data(), run);
+    if (run == text.size())
+    {
+      break;
+    }
+    out += table[static_cast<unsigned char>(text[run])];
+    text.remove_prefix(run + 1);
+  }
+}
+
+void XmlStream::put(const char *data, size_t size)
+{
+  if (file_ == nullptr)
+  {
+    return;
+  }
+  if (used_ + size > buffer_.size())
+  {
+    flush();
+    // Larger than the whole buffer: write straight through
+    if (size > buffer_.size())
+    {
+      failed_ |= std::fwrite(data, 1, size, file_) != size;
+      return;
+    }
+  }
+  std::memcpy(buffer_.data() + used_, data, size);
+  used_ += size;
+}
+
+bool XmlStream::flush()
+{
+  if (file_ != nullptr && used_ > 0)
+  {
+    failed_ |= std::fwrite(buffer_.data(), 1, used_, file_) != used_;
+    used_ = 0;
+  }
+  return !failed_;
+}
+
+bool XmlStream::checkpoint(std::string_view closing)
+{
+  flush();
+  if (file_ != nullptr)
+  {
+    failed_ |= std::fwrite(closing.data(), 1, closing.size(), file_) != closing.size();
+    failed_ |= std::fseek(file_, -static_cast<long>(closing.size()), SEEK_CUR) != 0;
+  }
+  return !failed_;
+}
+
+bool XmlStream::close()
+{
+  if (file_ == nullptr)
+  {
+    return !failed_;
+  }
+  flush();
+  failed_ |= std::fclose(file_) != 0;
+  file_ = nullptr;
+  return !failed_;
+}
+
+} // namespace utils
+} // namespace tUnit
@@ -0,0 +1,74 @@
+#include "tUnit.h"
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+TUNIT_TEST("Allocation Tracker", "No Allocations")
+{
+  std::vector<int> values(64);
+  std::iota(values.begin(), values.end(), 0);
+  long sum = 0;
+  test.expect_no_allocations("summing a vector allocates nothing", [&]()
+                             { sum = std::accumulate(values.begin(), values.end(), 0L); });
+  test.expect("the body ran", sum == 2016, true);
+}
+
+TUNIT_TEST("Allocation Tracker", "Counts", "[leaks]")
+{
+  tUnit::utils::AllocationStats stats;
+  {
+    tUnit::utils::AllocationScope scope;
+    auto first = std::make_unique<char[]>(100);
+    {
+      auto second = std::make_unique<char[]>(200);
+      tUnit::do_not_optimize(second.get());
+    }
+    auto kept = new char[50];
+    tUnit::do_not_optimize(first.get());
+    tUnit::do_not_optimize(kept); // otherwise the compiler may drop the new/delete pair
+    stats = scope.stats();
+    delete[] kept;
+  }
+  test.expect("hooks are linked into this binary", stats.tracked_, true);
+  test.expect("every allocation is counted", stats.allocations_ == 3, true);
+  test.expect("bytes are at least the requested sizes", stats.bytes_ >= 350, true);
+  test.expect("peak covers the first two at once", stats.peak_live_bytes_ >= 300, true);
+  test.expect("live bytes at the snapshot", stats.live_bytes_ >= 150 && static_cast<std::uint64_t>(stats.live_bytes_) < stats.bytes_, true);
+}
+
+TUNIT_TEST("Allocation Tracker", "Nested Scopes")
+{
+  // Snapshots only inside the scopes: building an assertion's description allocates too
+  tUnit::utils::AllocationStats inner_stats, folded, outer_stats;
+  {
+    tUnit::utils::AllocationScope outer;
+    std::unique_ptr<int> held;
+    {
+      tUnit::utils::AllocationScope inner;
+      held = std::make_unique<int>(7);
+      tUnit::do_not_optimize(held.get());
+      inner_stats = inner.stats();
+    }
+    folded = outer.stats();
+    held.reset();
+    outer_stats = outer.stats();
+  }
+  test.expect("inner scope sees its allocation", inner_stats.allocations_ == 1, true);
+  test.expect("and passes it to the enclosing scope", folded.allocations_ == 1 && folded.live_bytes_ > 0, true);
+  test.expect("the free balances it", outer_stats.live_bytes_ == 0 && outer_stats.leaked_bytes() == 0, true);
+
+  tUnit::utils::AllocationStats paused;
+  {
+    tUnit::utils::AllocationScope scope;
+    tUnit::utils::AllocationPause pause;
+    auto ignored = std::make_unique<int>(1);
+    tUnit::do_not_optimize(ignored.get());
+    paused = scope.stats();
+  }
+  test.expect("paused allocations are not charged", paused.allocations_ == 0, true);
+}
+
+} // anonymous namespace
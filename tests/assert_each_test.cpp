@@ -0,0 +1,54 @@
+#include "tUnit.h"
+#include <vector>
+
+namespace
+{
+namespace pred = tUnit::predicates;
+
+TUNIT_TEST("Assert Each", "Whole Range Is One Assertion")
+{
+  std::vector<int> values(100000);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<int>(i);
+  }
+  std::vector<int> successors(values.begin() + 1, values.end());
+  successors.push_back(static_cast<int>(values.size()));
+
+  const size_t before = test.results().total_;
+  test.assert_each("every value is non-negative", values, [](int value) { return value >= 0; });
+  test.assert_each("each value is less than its successor", values, pred::is_less{}, successors);
+  test.expect("a whole range is one assertion", test.results().total_ == before + 2);
+
+  auto even = tUnit::detail::check_each(values, pred::is_even{});
+  test.expect("failures are counted", !even.passed() && even.count_ == 100000 && even.failed_ == 50000);
+  test.expect("only the first failing indices are kept", even.first_failures_.size() == tUnit::EachResult::listed_failures && even.first_failures_[1] == 3);
+  test.expect("failures are described with their values", tUnit::detail::describe_each("all even", even) ==
+                                                              "all even: 50000 of 100000 elements failed, first at [1] = 1, [3] = 3, [5] = 5, [7] = 7, "
+                                                              "[9] = 9, [11] = 11, [13] = 13, [15] = 15, ...");
+
+  std::vector<int> shorter = {0, 1, 5};
+  pred::is_equal equal;
+  auto pairs = tUnit::detail::check_each(values, equal, shorter);
+  test.expect("pairs are checked over the common length", pairs.count_ == 3 && pairs.failed_ == 1 && pairs.first_failures_[0] == 2);
+  test.expect("a length mismatch fails the check", tUnit::detail::describe_each("copies match", pairs) ==
+                                                       "copies match: lengths differ (100000 vs 3); 1 of 3 elements failed, first at [2] = 2, 5");
+}
+
+TUNIT_TEST("Assert Each", "Predicate Called Once Per Element")
+{
+  // Fails the first half: a second call per element would change the answer
+  std::vector<int> values(20);
+  size_t calls = 0;
+  auto stateful = [&calls, &values](int) { return ++calls > values.size() / 2; };
+  auto single = tUnit::detail::check_each(values, stateful);
+  test.expect("each element is checked once", calls == 20 && single.count_ == 20);
+  test.expect("the listed failures are the counted ones", single.failed_ == 10 && single.first_failures_.size() == tUnit::EachResult::listed_failures && single.first_failures_.back() == 7);
+
+  calls = 0;
+  auto stateful_pair = [&calls, &values](int, int) { return ++calls > values.size() / 2; };
+  auto pairs = tUnit::detail::check_each(values, stateful_pair, values);
+  test.expect("each pair is checked once", calls == 20 && pairs.failed_ == 10 && pairs.first_failures_.front() == 0);
+}
+
+} // anonymous namespace
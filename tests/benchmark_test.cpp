@@ -0,0 +1,88 @@
+#include "tUnit.h"
+#include "utils/statistics.h"
+#include <numeric>
+#include <vector>
+
+namespace
+{
+
+// Short enough to keep the suite fast; real benchmarks use the defaults
+const tUnit::BenchmarkOptions quick{std::chrono::microseconds(200), std::chrono::microseconds(100), 5};
+
+TUNIT_TEST("Benchmark", "Statistics", "[bench]")
+{
+  std::vector<int> values(256);
+  std::iota(values.begin(), values.end(), 0);
+
+  auto result = test.benchmark("sum 256 ints", [&values]()
+                               {
+    long sum = std::accumulate(values.begin(), values.end(), 0L);
+    tUnit::do_not_optimize(sum); }, quick);
+
+  test.expect("one sample per repetition", result.samples_ns_.size() == quick.samples_, true);
+  test.expect("calibration reaches the minimum sample time", static_cast<double>(result.iterations_) * result.min_ns_ >= 0.5 * static_cast<double>(quick.min_sample_time_.count()), true);
+  test.expect("min <= median <= max sample", result.min_ns_ <= result.median_ns_ && result.median_ns_ <= *std::max_element(result.samples_ns_.begin(), result.samples_ns_.end()), true);
+  test.expect("ops/s is the inverse of the mean", result.ops_per_second() * result.mean_ns_ > 0.999e9 && result.ops_per_second() * result.mean_ns_ < 1.001e9, true);
+
+  const auto &recorded = test.results().benchmarks_;
+  test.expect("the result is recorded with the test", recorded.size() == 1 && recorded[0].name_ == "sum 256 ints", true);
+}
+
+TUNIT_TEST("Benchmark", "Summary Math")
+{
+  tUnit::BenchmarkResult result;
+  result.samples_ns_ = {4, 1, 3, 2};
+  tUnit::detail::summarize(result);
+  test.expect("min", result.min_ns_ == 1, true);
+  test.expect("even-count median averages the middle pair", result.median_ns_ == 2.5, true);
+  test.expect("mean", result.mean_ns_ == 2.5, true);
+  test.expect("sample standard deviation", result.stddev_ns_ > 1.2909 && result.stddev_ns_ < 1.2910, true);
+}
+
+TUNIT_TEST("Benchmark", "Mann-Whitney U")
+{
+  using tUnit::utils::mann_whitney_greater_p;
+  const std::vector<double> base = {10, 11, 12, 13, 14};
+  const std::vector<double> slower = {20, 21, 22, 23, 24};
+
+  // 1 of the C(10,5) = 252 orderings puts every candidate above every baseline sample
+  const double separated = mann_whitney_greater_p(base, slower);
+  test.expect("fully separated samples: exact p = 1/252", separated > 0.003967 && separated < 0.003969, true);
+  test.expect("faster candidate is not a regression", mann_whitney_greater_p(slower, base) > 0.99, true);
+
+  const std::vector<double> interleaved = {10.5, 11.5, 12.5, 13.5, 14.5};
+  const double shifted = mann_whitney_greater_p(base, interleaved);
+  test.expect("slightly shifted samples are not significant", shifted > 0.2 && shifted < 0.5, true);
+
+  std::vector<double> big_base, big_slower;
+  for (int i = 0; i < 40; ++i)
+  {
+    big_base.push_back(100 + i % 7);
+    big_slower.push_back(104 + i % 7); // ties: normal approximation
+  }
+  test.expect("large tied samples use the normal approximation", mann_whitney_greater_p(big_base, big_slower) < 0.001, true);
+  test.expect("empty sample", mann_whitney_greater_p({}, slower) == 1.0, true);
+  test.expect("median", tUnit::utils::median({5, 1, 3}) == 3 && tUnit::utils::median({4, 1, 3, 2}) == 2.5, true);
+}
+
+TUNIT_TEST("Benchmark", "Perf Counts")
+{
+  using tUnit::utils::PerfCounts;
+  PerfCounts start, end;
+  start.available_ = end.available_ = (1u << PerfCounts::cycles) | (1u << PerfCounts::instructions);
+  end.available_ |= 1u << PerfCounts::page_faults; // only in one reading: not in the difference
+  start.values_[PerfCounts::cycles] = 100;
+  end.values_[PerfCounts::cycles] = 1100;
+  start.values_[PerfCounts::instructions] = 500;
+  end.values_[PerfCounts::instructions] = 2500;
+  end.values_[PerfCounts::page_faults] = 7;
+
+  const PerfCounts delta = end - start;
+  test.expect("differences of common events", delta.has(PerfCounts::cycles) && delta[PerfCounts::cycles] == 1000 && delta[PerfCounts::instructions] == 2000, true);
+  test.expect("events missing from either reading are absent", delta.has(PerfCounts::page_faults) || delta.has(PerfCounts::llc_misses), false);
+  test.expect("formatted with IPC", tUnit::utils::format_counts(delta) == "cycles 1e+03, instructions 2e+03 (IPC 2.00)", true);
+  test.expect("formatted per iteration", tUnit::utils::format_counts(delta, 1000) == "cycles 1, instructions 2 (IPC 2.00)", true);
+  test.expect("nothing available formats as empty", tUnit::utils::format_counts(PerfCounts{}).empty(), true);
+}
+
+} // anonymous namespace
@@ -1,39 +1,43 @@
 #include "tUnit.h"
+#include <algorithm>
+#include <limits>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace
 {
 namespace pred = tUnit::predicates;
 
-auto &suite = tUnit::Orchestrator::instance().get_suite("Evaluator Core");
+// Decided by the compiler in Release builds (TUNIT_MODE=1), at startup otherwise
+TUNIT_STATIC_ASSERT(pred::is_less{}, 10, 20);
+TUNIT_STATIC_ASSERT(pred::is_equal{}, 'a', 97);
+TUNIT_STATIC_ASSERT(pred::starts_with{}, "compile time", "compile");
+TUNIT_STATIC_ASSERT(pred::is_even{}, 4, 8);
 
-void test_basic_evaluator_operations()
+TUNIT_TEST("Evaluator Core", "Basic Evaluator Operations")
 {
-  auto &test = suite.get_test("Basic Evaluator Operations");
   tUnit::Evaluator eval1(10, 20, pred::is_less{});
   test.expect("Evaluator(10, 20, is_less) operator()", eval1(), true);
   test.expect("Evaluator(10, 20, is_less) evaluate()", eval1.evaluate(), true);
 }
 
-void test_evaluator_use_method()
+TUNIT_TEST("Evaluator Core", "Evaluator Use Method")
 {
-  auto &test = suite.get_test("Evaluator Use Method");
   tUnit::Evaluator eval1(10, 20, pred::is_less{});
   test.expect("Evaluator use(5, 15)", eval1.use(5, 15), true);
   test.expect("Evaluator use(25, 15)", eval1.use(25, 15), false);
 }
 
-void test_evaluator_compare_method()
+TUNIT_TEST("Evaluator Core", "Evaluator Compare Method")
 {
-  auto &test = suite.get_test("Evaluator Compare Method");
   tUnit::Evaluator eval1(10, 20, pred::is_less{});
   test.expect("Evaluator compare(30)", eval1.compare(30), true);
   test.expect("Evaluator compare(5)", eval1.compare(5), false);
 }
 
-void test_different_predicate_types()
+TUNIT_TEST("Evaluator Core", "Different Predicate Types")
 {
-  auto &test = suite.get_test("Different Predicate Types");
   tUnit::Evaluator eval2(5, 5, pred::is_equal{});
   test.expect("Evaluator(5, 5, is_equal)", eval2(), true);
   tUnit::Evaluator eval3(10, 5, pred::is_greater{});
@@ -42,18 +46,16 @@ void test_different_predicate_types()
   test.expect("Evaluator(3, 7, is_less_equal)", eval4(), true);
 }
 
-void test_string_evaluators()
+TUNIT_TEST("Evaluator Core", "String Evaluators")
 {
-  auto &test = suite.get_test("String Evaluators");
   tUnit::Evaluator string_eval(std::string("hello"), std::string("he"), pred::starts_with{});
   test.expect("String Evaluator starts_with", string_eval(), true);
   test.expect("String Evaluator use(world, wo)", string_eval.use(std::string("world"), std::string("wo")), true);
   test.expect("String Evaluator compare(bye)", string_eval.compare(std::string("bye")), false);
 }
 
-void test_numeric_and_custom_evaluators()
+TUNIT_TEST("Evaluator Core", "Numeric and Custom Evaluators")
 {
-  auto &test = suite.get_test("Numeric and Custom Evaluators");
   tUnit::Evaluator float_eval(3.14, 3.0, pred::is_greater{});
   test.expect("Float Evaluator 3.14 > 3.0", float_eval(), true);
   auto custom_pred = [](int a, int b)
@@ -68,27 +70,96 @@ void test_numeric_and_custom_evaluators()
   test.expect("Range Evaluator compare(3)", range_eval.compare(3), false);
 }
 
-void test_negative_cases()
+TUNIT_TEST("Evaluator Core", "Negative Cases")
 {
-  auto &test = suite.get_test("Negative Cases");
   tUnit::Evaluator fail_eval(20, 10, pred::is_less{});
   test.expect("Evaluator(20, 10, is_less) should fail", fail_eval(), false);
 }
 
-struct TestRunner
+// Counts copies of itself, and of the predicate below, in a shared counter
+struct Counted
 {
-  TestRunner()
+  int *copies_;
+  int value_;
+
+  Counted(int *copies, int value) : copies_(copies), value_(value) {}
+  Counted(const Counted &other) : copies_(other.copies_), value_(other.value_) { ++*copies_; }
+  Counted(Counted &&other) noexcept = default;
+  bool operator==(const Counted &other) const { return value_ == other.value_; }
+};
+
+struct CountedEqual
+{
+  int *copies_;
+  int *calls_;
+
+  CountedEqual(int *copies, int *calls) : copies_(copies), calls_(calls) {}
+  CountedEqual(const CountedEqual &other) : copies_(other.copies_), calls_(other.calls_) { ++*copies_; }
+  CountedEqual(CountedEqual &&other) noexcept = default;
+  bool operator()(const Counted &lhs, const Counted &rhs) const
   {
-    test_basic_evaluator_operations();
-    test_evaluator_use_method();
-    test_evaluator_compare_method();
-    test_different_predicate_types();
-    test_string_evaluators();
-    test_numeric_and_custom_evaluators();
-    test_negative_cases();
+    ++*calls_;
+    return lhs == rhs;
   }
 };
 
-static TestRunner runner;
+TUNIT_TEST("Evaluator Core", "Operands Are Held By Reference")
+{
+  int copies = 0;
+  int calls = 0;
+  Counted lhs(&copies, 7);
+  Counted rhs(&copies, 7);
+  CountedEqual equal(&copies, &calls);
+
+  tUnit::Evaluator held(lhs, rhs, equal);
+  test.expect("lvalue operands and predicate are held, not copied", held() && copies == 0);
+  test.assert("Test::assert copies nothing", lhs, equal, rhs);
+  test.expect("the caller's predicate is the one evaluated", copies == 0 && calls == 2);
+
+  tUnit::Evaluator owned(Counted(&copies, 3), Counted(&copies, 3), CountedEqual(&copies, &calls));
+  test.expect("rvalues are moved in and owned", owned() && copies == 0);
+
+  const std::vector<int> big(1 << 20, 1);
+  tUnit::Evaluator view(big, big, pred::is_equal{});
+  static_assert(std::is_same_v<decltype(view), tUnit::Evaluator<const std::vector<int> &, const std::vector<int> &, pred::is_equal>>,
+                "lvalue containers deduce reference members");
+  test.expect("a container operand refers to the caller's container", view());
+}
+
+TUNIT_TEST("Evaluator Core", "Perfect Squares At Type Limits")
+{
+  constexpr long long max_ll = std::numeric_limits<long long>::max();
+  constexpr unsigned long long max_ull = std::numeric_limits<unsigned long long>::max();
+  constexpr unsigned long long root_ull = 4294967295ull; // floor(sqrt(max_ull))
+#if TUNIT_MODE
+  static_assert(!pred::is_perfect_square{}(max_ll) && !pred::is_perfect_square{}(max_ull) && pred::is_perfect_square{}(root_ull * root_ull),
+                "no overflow at the type limits");
+#endif
+  test.expect("0, 1 and 4 are squares", pred::is_perfect_square{}(0) && pred::is_perfect_square{}(1) && pred::is_perfect_square{}(4));
+  test.expect("2 and 3 are not", !pred::is_perfect_square{}(2) && !pred::is_perfect_square{}(3));
+  test.expect("negative values are not", !pred::is_perfect_square{}(-4) && !pred::is_perfect_square{}(std::numeric_limits<long long>::min()));
+  test.expect("INT64_MAX is not", !pred::is_perfect_square{}(max_ll));
+  test.expect("the largest square below INT64_MAX is", pred::is_perfect_square{}(3037000499ll * 3037000499ll) &&
+                                                             !pred::is_perfect_square{}(3037000499ll * 3037000499ll + 1));
+  test.expect("UINT64_MAX is not", !pred::is_perfect_square{}(max_ull));
+  test.expect("the largest unsigned long long square is", pred::is_perfect_square{}(root_ull * root_ull) &&
+                                                              !pred::is_perfect_square{}(root_ull * root_ull - 1));
+  test.expect("small types at their limits", pred::is_perfect_square{}(static_cast<unsigned char>(225)) &&
+                                                 !pred::is_perfect_square{}(std::numeric_limits<unsigned char>::max()) &&
+                                                 !pred::is_perfect_square{}(std::numeric_limits<int>::max()));
+}
+
+TUNIT_TEST("Evaluator Core", "Compile-Time Assertions", "[static]")
+{
+#if TUNIT_MODE
+  constexpr tUnit::Evaluator evaluator(3, 7, pred::is_less_equal{});
+  static_assert(evaluator() && evaluator.use(7, 7) && !evaluator.compare(2), "Evaluator is constexpr in TUNIT_MODE=1");
+  static_assert(pred::is_prime{}(97) && pred::is_perfect_square{}(144) && !pred::is_perfect_square{}(143), "custom predicates are constexpr");
+#endif
+  const auto &registrations = tUnit::Orchestrator::instance().registrations();
+  auto it = std::find_if(registrations.begin(), registrations.end(), [](const tUnit::TestRegistration &registration)
+                         { return registration.suite_name_ == "Static Assertions" && registration.test_name_ == __FILE__; });
+  test.expect("static assertions are registered as one test per file", it != registrations.end());
+}
 
 } // anonymous namespace
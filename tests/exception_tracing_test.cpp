@@ -5,8 +5,6 @@
 namespace
 {
 
-auto &suite = tUnit::Orchestrator::instance().get_suite("Exception Tracing");
-
 bool throwing_predicate(int value)
 {
   TUNIT_TRACE_FUNCTION();
@@ -39,9 +37,8 @@ bool complex_logical_predicate(int value)
   return nested_complex_predicate(value);
 }
 
-void test_basic_exception_tracing()
+TUNIT_TEST("Exception Tracing", "Basic Exception Tracing")
 {
-  auto &test = suite.get_test("Basic Exception Tracing");
   try
   {
     throwing_predicate(-5);
@@ -60,9 +57,8 @@ void test_basic_exception_tracing()
   }
 }
 
-void test_nested_exception_tracing()
+TUNIT_TEST("Exception Tracing", "Nested Exception Tracing")
 {
-  auto &test = suite.get_test("Nested Exception Tracing");
   try
   {
     nested_complex_predicate(42);
@@ -88,9 +84,8 @@ void test_nested_exception_tracing()
   }
 }
 
-void test_deep_nesting_exception_tracing()
+TUNIT_TEST("Exception Tracing", "Deep Nesting Exception Tracing")
 {
-  auto &test = suite.get_test("Deep Nesting Exception Tracing");
   try
   {
     complex_logical_predicate(999);
@@ -107,16 +102,4 @@ void test_deep_nesting_exception_tracing()
   }
 }
 
-struct ExceptionTracingTestRunner
-{
-  ExceptionTracingTestRunner()
-  {
-    test_basic_exception_tracing();
-    test_nested_exception_tracing();
-    test_deep_nesting_exception_tracing();
-  }
-};
-
-static ExceptionTracingTestRunner runner;
-
 } // anonymous namespace
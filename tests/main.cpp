@@ -2,8 +2,9 @@
 
 int main(int argc, char *argv[])
 {
-  // All test suites self register
+  // All test suites self register; registered tests execute in run()
   tUnit::Orchestrator::instance().parse_args(argc, argv);
+  tUnit::Orchestrator::instance().run();
   tUnit::Orchestrator::instance().write_xml_output();
   tUnit::Orchestrator::instance().print_summary();
   return tUnit::Orchestrator::instance().all_tests_passed() ? 0 : 1;
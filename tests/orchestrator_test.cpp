@@ -0,0 +1,526 @@
+#include "tUnit.h"
+#include "tUnit/reporters.h"
+#include "tUnit/result_format.h"
+#include "utils/byte_stream.h"
+#include "utils/hash.h"
+#include "utils/watchdog.h"
+#include "utils/work_stealing_pool.h"
+#include "utils/xml_stream.h"
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+auto &suite = tUnit::Orchestrator::instance().get_suite("Orchestrator");
+
+// Parses xml as far as well-formedness goes (one root, tags closed in order, quoted attribute
+// values); the number of testcase elements, or -1 if an XML parser would reject it
+long parse_junit(std::string_view xml)
+{
+  std::vector<std::string_view> open;
+  bool root_closed = false;
+  long testcases = 0;
+  size_t pos = 0;
+  while ((pos = xml.find('<', pos)) != std::string_view::npos)
+  {
+    size_t end = pos + 1;
+    bool quoted = false;
+    for (; end < xml.size() && (quoted || xml[end] != '>'); ++end)
+    {
+      if (xml[end] == '"') quoted = !quoted;
+      if (!quoted && xml[end] == '<') return -1;
+    }
+    if (end >= xml.size() || end == pos + 1) return -1;
+    std::string_view tag = xml.substr(pos + 1, end - pos - 1);
+    pos = end + 1;
+    if (tag.front() == '?') continue;
+    if (root_closed) return -1;
+    if (tag.front() == '/')
+    {
+      if (open.empty() || open.back() != tag.substr(1)) return -1;
+      open.pop_back();
+      root_closed = open.empty();
+      continue;
+    }
+    std::string_view name = tag.substr(0, tag.find_first_of(" \t\r\n/"));
+    testcases += name == "testcase";
+    if (tag.back() != '/')
+    {
+      open.push_back(name);
+    }
+    else if (open.empty())
+    {
+      root_closed = true;
+    }
+  }
+  return root_closed && xml.find_first_not_of(" \t\r\n", xml.rfind('>') + 1) == std::string_view::npos ? testcases : -1;
+}
+
+TUNIT_TEST("Orchestrator", "Handle Lookup")
+{
+  auto &orchestrator = tUnit::Orchestrator::instance();
+  std::string_view suite_name = "Orchestrator";
+  std::string_view test_name = "Handle Lookup";
+  test.expect("get_test returns the same test for string_view names", &orchestrator.get_test(suite_name, test_name) == &test, true);
+  test.expect("suite get_test returns the same test", &suite.get_test(test_name) == &test, true);
+  test.expect("assertions_for reads through the test handle", &orchestrator.assertions_for(suite_name, test_name) == &test.results().assertions_, true);
+}
+
+TUNIT_TEST("Orchestrator", "Running Counters")
+{
+  // A dedicated suite keeps the suite totals exact while other tests run in parallel
+  auto &orchestrator = tUnit::Orchestrator::instance();
+  auto &counted_suite = orchestrator.get_suite("Orchestrator (counters)");
+  auto &counted = counted_suite.get_test("Running Counters");
+  size_t total_before = orchestrator.total_assertions();
+  counted.expect("first assertion", true);
+  counted.expect("second assertion", true);
+  test.expect("global counter advanced", orchestrator.total_assertions() >= total_before + 2, true);
+  test.expect("suite counter matches logged assertions", counted_suite.counters().assertions_ == 2, true);
+  test.expect("test counter matches logged assertions", test.results().total_ == 2, true);
+  test.expect("no failures indexed", counted.results().failures_.empty(), true);
+}
+
+// Retention is global, so every check that changes it lives in this one test
+TUNIT_TEST("Orchestrator", "Retention Policy")
+{
+  auto &counting = suite.get_test("Retention Policy (counting only)");
+  auto &repeated = suite.get_test("Retention Policy (interned descriptions)");
+  auto &orchestrator = tUnit::Orchestrator::instance();
+  const auto retention = orchestrator.retention();
+  const auto pass_limit = orchestrator.pass_limit();
+
+  orchestrator.set_retention(tUnit::Retention::all);
+  for (int i = 0; i < 3; ++i)
+  {
+    repeated.expect(std::string("same description ") + "built at runtime", true);
+  }
+  orchestrator.set_retention(tUnit::Retention::failures_and_first, 2);
+  for (int i = 0; i < 10; ++i)
+  {
+    counting.expect("passing check up to the limit", true);
+  }
+  orchestrator.set_retention(tUnit::Retention::failures);
+  for (int i = 0; i < 1000; ++i)
+  {
+    counting.expect("passing check in a loop", true);
+  }
+  int described = 0;
+  auto describe = [&]()
+  {
+    ++described;
+    return "check " + std::to_string(described);
+  };
+  test.expect_no_allocations("unretained passes allocate nothing", [&]()
+                             {
+    for (int i = 0; i < 100; ++i)
+    {
+      counting.expect("passing literal", true);
+      counting.expect(describe, true);
+      counting.assert(describe, i, tUnit::predicates::is_less{}, 100);
+    } });
+  orchestrator.set_retention(tUnit::Retention::all);
+  repeated.expect(describe, true);
+  orchestrator.set_retention(retention, pass_limit);
+
+  test.expect("passing assertions are still counted", counting.results().total_ == 1310, true);
+  test.expect("only the first passes are stored", counting.results().assertions_.size() == 2, true);
+  test.expect("lazy descriptions are only built when stored", described == 1 && repeated.results().assertions_.back().description_ == "check 1", true);
+
+  const auto &assertions = repeated.results().assertions_;
+  test.expect("repeated descriptions share one interned copy", assertions.size() == 4 && assertions[0].description_.data() == assertions[2].description_.data(), true);
+}
+
+TUNIT_TEST("Orchestrator", "Interned Descriptions")
+{
+  tUnit::utils::StringInterner interner;
+  std::string_view first = interner.intern("alpha");
+  std::string_view second = interner.intern(std::string("alpha"));
+  interner.intern("beta");
+  test.expect("interner deduplicates equal strings", first.data() == second.data(), true);
+  test.expect("interner stores each unique string once", interner.size() == 2 && interner.bytes_used() == 9, true);
+}
+
+TUNIT_TEST("Orchestrator", "Shared Interner", "[threads]")
+{
+  // Every thread interns the same texts in a different order, growing the table as it goes
+  constexpr int thread_count = 8;
+  constexpr int unique = 5000;
+  tUnit::utils::StringInterner interner;
+  std::vector<std::vector<std::string_view>> views(thread_count, std::vector<std::string_view>(unique));
+  std::vector<std::thread> workers;
+  for (int t = 0; t < thread_count; ++t)
+  {
+    workers.emplace_back([&interner, &views, t]()
+                         {
+      for (int i = 0; i < unique; ++i)
+      {
+        const int n = (i * 7 + t * 613) % unique;
+        views[t][n] = interner.intern("description " + std::to_string(n));
+      } });
+  }
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+
+  bool same = true;
+  for (int t = 1; t < thread_count; ++t)
+  {
+    for (int n = 0; n < unique; ++n)
+    {
+      same &= views[t][n].data() == views[0][n].data();
+    }
+  }
+  test.expect("threads share one copy of each text", same && interner.size() == unique, true);
+  test.expect("interned views keep their text", views[3][1234] == "description 1234", true);
+}
+
+TUNIT_TEST("Orchestrator", "Concurrent Assertions", "[threads]")
+{
+  auto &shared = suite.get_test("Concurrent Assertions (shared)");
+  constexpr int thread_count = 8;
+  constexpr int per_thread = 10000;
+
+  std::vector<std::thread> workers;
+  for (int t = 0; t < thread_count; ++t)
+  {
+    workers.emplace_back([&shared, t]()
+                         {
+      auto &own = suite.get_test("Concurrent Assertions (worker " + std::to_string(t) + ")");
+      for (int i = 0; i < per_thread; ++i)
+      {
+        shared.expect("shared test from worker", true);
+        own.expect("own test from worker", i >= 0);
+      } });
+  }
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+
+  test.expect("every shared assertion is merged", shared.results().total_ == thread_count * per_thread, true);
+  test.expect("worker tests are registered once each", suite.get_test("Concurrent Assertions (worker 3)").results().total_ == per_thread, true);
+
+  // The pass limit is per test, not per thread
+  auto &limited = suite.get_test("Concurrent Assertions (first passes)");
+  auto &orchestrator = tUnit::Orchestrator::instance();
+  const auto retention = orchestrator.retention();
+  const auto pass_limit = orchestrator.pass_limit();
+  orchestrator.set_retention(tUnit::Retention::failures_and_first, 5);
+  workers.clear();
+  for (int t = 0; t < thread_count; ++t)
+  {
+    workers.emplace_back([&limited]()
+                         {
+      for (int i = 0; i < 100; ++i)
+      {
+        limited.expect("first passes from every thread", true);
+      } });
+  }
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+  orchestrator.set_retention(retention, pass_limit);
+  test.expect("threads share one pass limit", limited.results().assertions_.size() == 5 && limited.results().total_ == thread_count * 100, true);
+}
+
+TUNIT_TEST("Orchestrator", "Work Stealing Pool", "[threads]")
+{
+  constexpr size_t task_count = 1000;
+  std::vector<std::atomic<int>> runs(task_count);
+  tUnit::utils::WorkStealingPool pool(4);
+  pool.run(task_count, [&runs](size_t, size_t index)
+           { runs[index].fetch_add(1); });
+
+  bool each_once = true;
+  for (const auto &count : runs)
+  {
+    each_once = each_once && count.load() == 1;
+  }
+  test.expect("every task runs exactly once", each_once, true);
+  test.expect("pool keeps its worker count", pool.workers() == 4, true);
+}
+
+TUNIT_TEST("Orchestrator", "Watchdog Timers", "[threads]")
+{
+  using Clock = tUnit::utils::Watchdog::Clock;
+  std::mutex mutex;
+  std::condition_variable done;
+  std::vector<int> fired;
+  auto record = [&](int id)
+  {
+    return [&, id]()
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      fired.push_back(id);
+      done.notify_one();
+    };
+  };
+
+  {
+    tUnit::utils::Watchdog watchdog;
+    const auto now = Clock::now();
+    watchdog.arm(now + std::chrono::milliseconds(30), record(3));
+    const auto cancelled = watchdog.arm(now + std::chrono::milliseconds(5), record(0));
+    watchdog.arm(now + std::chrono::milliseconds(20), record(2));
+    watchdog.arm(now + std::chrono::milliseconds(10), record(1));
+    watchdog.cancel(cancelled);
+    watchdog.arm(now + std::chrono::hours(1), record(4)); // pending at shutdown: never fires
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait_for(lock, std::chrono::seconds(5), [&]()
+                  { return fired.size() >= 3; });
+  }
+  test.expect("timers fire in deadline order, cancelled and pending ones never", fired == std::vector<int>{1, 2, 3}, true);
+
+  std::atomic<bool> started{false};
+  std::atomic<bool> ended{false};
+  {
+    tUnit::utils::Watchdog watchdog;
+    const auto id = watchdog.arm(Clock::now(), [&]()
+                                 {
+      started = true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      ended = true; });
+    while (!started)
+    {
+      std::this_thread::yield();
+    }
+    watchdog.cancel(id);
+    test.expect("cancel waits for a callback already running", ended.load(), true);
+  }
+}
+
+TUNIT_TEST("Orchestrator", "Deferred Registration")
+{
+  const auto &registrations = tUnit::Orchestrator::instance().registrations();
+  bool registered = false;
+  for (const auto &registration : registrations)
+  {
+    registered = registered || (registration.suite_name_ == "Orchestrator" && registration.test_name_ == "Deferred Registration");
+  }
+  test.expect("TUNIT_TEST records the test in the registry", registered, true);
+  test.expect("the running test is the one created for the registration", &suite.get_test("Deferred Registration") == &test, true);
+}
+
+TUNIT_TEST("Orchestrator", "Test Filter")
+{
+  using tUnit::TestFilter;
+  test.expect("glob * spans separators", TestFilter::glob_match("Integration*::Complex*", "Integration Tests::Complex Logical Combinations"), true);
+  test.expect("glob ? matches one character", TestFilter::glob_match("a?c", "abc"), true);
+  test.expect("glob must match the whole name", TestFilter::glob_match("Integration", "Integration Tests::X"), false);
+  test.expect("glob backtracks over stars", TestFilter::glob_match("*a*b", "xaayab"), true);
+
+  auto &orchestrator = tUnit::Orchestrator::instance();
+  tUnit::TagMask threads = orchestrator.tag_mask("[threads]");
+  tUnit::TagMask slow = orchestrator.tag_mask("[slow]");
+
+  TestFilter by_tag;
+  by_tag.include("[threads]", threads);
+  test.expect("tag pattern selects tagged tests", by_tag.selects("S::T", threads | slow), true);
+  test.expect("tag pattern skips untagged tests", by_tag.selects("S::T", slow), false);
+
+  TestFilter combined;
+  combined.include("/^Orchestrator::/");
+  combined.exclude("[slow]", slow);
+  combined.exclude("*Pool");
+  test.expect("regex include selects matching names", combined.selects("Orchestrator::Test Filter", {}), true);
+  test.expect("regex include skips other suites", combined.selects("Syntax Demo::Expectations", {}), false);
+  test.expect("tag exclude wins over include", combined.selects("Orchestrator::Test Filter", slow), false);
+  test.expect("glob exclude wins over include", combined.selects("Orchestrator::Work Stealing Pool", {}), false);
+}
+
+TUNIT_TEST("Orchestrator", "Stable Shard Hash")
+{
+  // Shards in different processes (or on different machines) must agree on the split
+  using tUnit::utils::fnv1a;
+  static_assert(fnv1a("") == 0xcbf29ce484222325ULL, "FNV-1a offset basis");
+  test.expect("FNV-1a matches the reference value", fnv1a("a") == 0xaf63dc4c8601ec8cULL, true);
+  test.expect("hash depends on the full name", fnv1a("Suite::Test") != fnv1a("Suite::Tess"), true);
+}
+
+TUNIT_TEST("Orchestrator", "Worker Wire Format")
+{
+  // Results from isolated worker processes travel in this encoding
+  constexpr std::string_view embedded_nul("description with \0 inside", 25);
+  tUnit::utils::ByteWriter writer;
+  writer.u8(1);
+  writer.u32(0xdeadbeef);
+  writer.u64(1ULL << 40);
+  writer.str(embedded_nul);
+
+  tUnit::utils::ByteReader reader(writer.bytes());
+  std::uint8_t flag = 0;
+  std::uint32_t word = 0;
+  std::uint64_t wide = 0;
+  std::string_view text;
+  test.expect("fields read back in order", reader.u8(flag) && reader.u32(word) && reader.u64(wide) && reader.str(text), true);
+  test.expect("values round-trip", flag == 1 && word == 0xdeadbeef && wide == (1ULL << 40), true);
+  test.expect("strings keep their length prefix", text == embedded_nul, true);
+  test.expect("reading past the end fails", reader.u8(flag), false);
+
+  tUnit::utils::ByteReader truncated(std::string_view(writer.bytes()).substr(0, 10));
+  test.expect("truncated input is rejected", truncated.u8(flag) && truncated.u32(word) && truncated.u64(wide), false);
+}
+
+TUNIT_TEST("Orchestrator", "XML Escaping")
+{
+  auto escape = [](std::string_view text)
+  {
+    std::string out;
+    tUnit::utils::XmlStream::escape_to(out, text);
+    return out;
+  };
+  test.expect("plain text is copied", escape("a == b") == "a == b", true);
+  test.expect("markup characters become entities", escape("x < 5 && \"y\" > 'z'") == "x &lt; 5 &amp;&amp; &quot;y&quot; &gt; &apos;z&apos;", true);
+  test.expect("control characters become U+FFFD", escape("a\x01" "b") == "a\xEF\xBF\xBD" "b", true);
+  test.expect("tabs, newlines and UTF-8 are kept", escape("\tline\n\xC3\xA9") == "\tline\n\xC3\xA9", true);
+  std::string attribute;
+  tUnit::utils::XmlStream::escape_to(attribute, "\tline\r\nnext", true);
+  test.expect("attributes keep tabs and line breaks as references", attribute == "&#9;line&#13;&#10;next", true);
+}
+
+TUNIT_TEST("Orchestrator", "Reporters")
+{
+  const auto dir = std::filesystem::temp_directory_path();
+  const std::string tap_path = (dir / "tunit_reporter_test.tap").string();
+  const std::string jsonl_path = (dir / "tunit_reporter_test.jsonl").string();
+  const std::string junit_path = (dir / "tunit_reporter_test.xml").string();
+  const std::string streamed_path = (dir / "tunit_reporter_test_streamed.xml").string();
+  auto read = [](const std::string &path)
+  {
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+  };
+
+  auto wall = [](std::int64_t ns)
+  {
+    tUnit::TestTiming timing;
+    timing.wall_ = std::chrono::nanoseconds(ns);
+    return timing;
+  };
+  tUnit::TestOutcome passed{test, 3, 0, {}, wall(1500), {}};
+  tUnit::TestOutcome failed{test, 2, 1, {"got \"x\"\n# not a directive"}, wall(0), {}};
+  {
+    tUnit::TapReporter tap(tap_path);
+    tUnit::JsonLinesReporter jsonl(jsonl_path);
+    for (tUnit::Listener *listener : {static_cast<tUnit::Listener *>(&tap), static_cast<tUnit::Listener *>(&jsonl)})
+    {
+      listener->test_finished(passed);
+      listener->test_finished(failed);
+    }
+    tap.run_finished(tUnit::Orchestrator::instance());
+
+    tUnit::JUnitReporter junit(junit_path, true); // only the streamed file, run_finished rewrites it
+    junit.test_finished(passed);
+    junit.test_finished(failed);
+
+    // Never finished, as in a run that crashed: every testcase so far must still parse
+    tUnit::JUnitReporter streamed(streamed_path);
+    streamed.test_started(test);
+    test.expect("streamed JUnit parses before the first test finishes", parse_junit(read(streamed_path)) == 0, true);
+    streamed.test_finished(passed);
+    test.expect("streamed JUnit parses after one test", parse_junit(read(streamed_path)) == 1, true);
+    streamed.test_finished(failed);
+    test.expect("streamed JUnit parses after two tests", parse_junit(read(streamed_path)) == 2, true);
+  }
+  test.expect("a malformed report is rejected", parse_junit("<testsuites>\n  <testsuite name=\"partial\">\n") == -1, true);
+
+  const std::string tap = read(tap_path);
+  test.expect("TAP numbers tests and puts the plan last", tap.rfind("TAP version 13\nok 1 - Orchestrator::Reporters\nnot ok 2 - Orchestrator::Reporters\n", 0) == 0 && tap.size() > 5 && tap.compare(tap.size() - 5, 5, "1..2\n") == 0, true);
+
+  const std::string jsonl = read(jsonl_path);
+  test.expect("JSON lines has one object per test", jsonl.find("\"passed\":true,\"assertions\":3,\"failed\":0,\"wall_ns\":1500") != std::string::npos, true);
+  test.expect("JSON strings are escaped", jsonl.find("[\"got \\\"x\\\"\\n# not a directive\"]") != std::string::npos, true);
+
+  const std::string junit = read(junit_path);
+  test.expect("streamed JUnit honours failures only", junit.find("<testcase") == junit.rfind("<testcase") && junit.find("assertions=\"2\"") != std::string::npos, true);
+  test.expect("JUnit attributes keep line breaks", junit.find("message=\"got &quot;x&quot;&#10;# not a directive\"") != std::string::npos, true);
+
+  std::filesystem::remove(tap_path);
+  std::filesystem::remove(jsonl_path);
+  std::filesystem::remove(junit_path);
+  std::filesystem::remove(streamed_path);
+}
+
+TUNIT_TEST("Orchestrator", "Binary Results Format")
+{
+  namespace format = tUnit::result_format;
+  format::Writer writer;
+  format::TestRecord first{"Suite", "first", 4, 1, 250, {"broken"}, 120, 30, {}, {}, {}};
+  format::TestRecord second{"Suite", "second", 2, 2, 0, {"broken", "worse"}, 0, 0, {}, {}, {}};
+  first.counters_.values_[tUnit::utils::PerfCounts::instructions] = 5000;
+  first.counters_.values_[tUnit::utils::PerfCounts::page_faults] = 3;
+  first.counters_.available_ = (1u << tUnit::utils::PerfCounts::instructions) | (1u << tUnit::utils::PerfCounts::page_faults);
+  writer.add_test(first);
+  writer.add_test(second);
+  const std::string image = writer.bytes();
+
+  std::vector<std::string> seen;
+  bool fields_match = true;
+  auto collect = [&](const format::TestRecord &record)
+  {
+    seen.push_back(std::string(record.suite_) + "::" + std::string(record.test_));
+    fields_match = fields_match && (record.test_ != "first" || (record.assertions_ == 4 && record.failed_ == 1 && record.wall_ns_ == 250 && record.failures_.size() == 1 && record.user_ns_ == 120 && record.system_ns_ == 30 &&
+                                                                    record.counters_.available_ == first.counters_.available_ && record.counters_.values_ == first.counters_.values_));
+    fields_match = fields_match && (record.test_ != "second" || (record.failures_.size() == 2 && record.failures_[1] == "worse" && !record.counters_.any()));
+  };
+
+  test.expect("records round-trip in order", format::read(image, collect) && seen == std::vector<std::string>{"Suite::first", "Suite::second"}, true);
+  test.expect("record fields round-trip", fields_match, true);
+  size_t suite_copies = 0;
+  for (size_t pos = image.find("Suite"); pos != std::string::npos; pos = image.find("Suite", pos + 1))
+  {
+    ++suite_copies;
+  }
+  test.expect("repeated strings are interned", suite_copies == 1 && image.find("broken") == image.rfind("broken"), true);
+
+  seen.clear();
+  std::string error;
+  test.expect("a truncated file is an error", format::read(std::string_view(image).substr(0, image.size() - 3), collect, &error), false);
+  test.expect("records before the cut are still delivered", seen.size() == 1 && error.rfind("truncated record at byte ", 0) == 0, true);
+
+  // Counts far beyond the payload are rejected before anything is allocated for them
+  auto hostile = [](std::uint32_t failures, std::uint32_t benchmarks)
+  {
+    tUnit::utils::ByteWriter fields;
+    fields.u32(0);
+    fields.u32(0);
+    fields.u64(1);
+    fields.u64(1);
+    fields.u64(0);
+    fields.u32(failures);
+    fields.u64(0);
+    fields.u64(0);
+    fields.u32(benchmarks);
+    tUnit::utils::ByteWriter out;
+    out.bytes().append(format::magic);
+    out.u32(format::version);
+    out.u8(static_cast<std::uint8_t>(format::RecordType::string));
+    out.str("S");
+    out.u8(static_cast<std::uint8_t>(format::RecordType::test));
+    out.str(fields.bytes());
+    return out.bytes();
+  };
+  test.expect("a huge failure count is corrupt", format::read(hostile(0xffffffffu, 0), collect, &error), false);
+  test.expect("a huge benchmark count is corrupt", format::read(hostile(0, 0xffffffffu), collect, &error), false);
+
+  std::string future = image;
+  future[4] = 9;
+  test.expect("other versions are rejected", format::read(future, collect, &error), false);
+  test.expect("the error names the version", error == "unsupported results format version 9", true);
+}
+
+} // anonymous namespace
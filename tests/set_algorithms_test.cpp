@@ -0,0 +1,187 @@
+#include "tUnit.h"
+#include <algorithm>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+namespace pred = tUnit::predicates;
+namespace detail = tUnit::predicates::detail;
+
+// Equality only: no hash, no ordering, so only the nested loops apply
+struct Opaque
+{
+  int value_;
+  bool operator==(const Opaque &other) const { return value_ == other.value_; }
+};
+
+// Orderable but not hashable
+struct Ranked
+{
+  int value_;
+  bool operator==(const Ranked &other) const { return value_ == other.value_; }
+  bool operator<(const Ranked &other) const { return value_ < other.value_; }
+};
+
+// Ordered by key alone: elements differing only in payload are neither < the other, yet unequal
+struct Keyed
+{
+  int key_;
+  int payload_;
+  bool operator==(const Keyed &other) const { return key_ == other.key_ && payload_ == other.payload_; }
+  bool operator<(const Keyed &other) const { return key_ < other.key_; }
+};
+
+template <typename T>
+T make(int i)
+{
+  if constexpr (std::is_same_v<T, std::string>)
+  {
+    return "value-" + std::to_string(i);
+  }
+  else if constexpr (std::is_same_v<T, Keyed>)
+  {
+    return Keyed{i / 3, i % 3}; // runs of up to three equivalent, unequal elements
+  }
+  else
+  {
+    return T{i};
+  }
+}
+
+// Every strategy against the nested loops, on sizes either side of small_work
+template <typename T>
+bool strategies_agree(std::mt19937 &rng)
+{
+  bool same = true;
+  for (int n : {0, 1, 5, 40, 300})
+  {
+    for (int range : {n / 2 + 1, 4 * n + 1})
+    {
+      std::vector<T> values;
+      std::vector<T> others;
+      std::uniform_int_distribution<int> pick(0, range);
+      for (int i = 0; i < n; ++i)
+      {
+        values.push_back(make<T>(pick(rng)));
+        others.push_back(make<T>(pick(rng)));
+      }
+      std::vector<T> shuffled = values;
+      std::shuffle(shuffled.begin(), shuffled.end(), rng);
+      std::vector<T> sorted = values;
+      std::sort(sorted.begin(), sorted.end());
+      std::vector<T> subset(values.begin(), values.begin() + n / 2);
+
+      const bool unique = detail::unique_nested(values);
+      if constexpr (detail::is_hashable<T>::value)
+      {
+        same &= detail::unique_hashed(values) == unique;
+      }
+      same &= detail::unique_sorted(values) == unique && detail::unique_sorted_input(sorted) == unique &&
+              detail::is_unique(values) == unique && detail::is_unique(sorted) == unique;
+
+      for (const auto *needles : {&others, &subset, &shuffled})
+      {
+        for (bool all : {true, false})
+        {
+          const bool found = detail::contains_nested(values, *needles, all);
+          if constexpr (detail::is_hashable<T>::value)
+          {
+            same &= detail::contains_hashed(values, *needles, all) == found;
+          }
+          same &= detail::contains_sorted(values, *needles, all) == found &&
+                  detail::contains_sorted_input(sorted, *needles, all) == found && detail::contains(values, *needles, all) == found &&
+                  detail::contains(sorted, *needles, all) == found;
+        }
+      }
+
+      for (const auto *other : {&others, &shuffled, &sorted})
+      {
+        const bool permutation = detail::permutation_nested(values, *other);
+        if constexpr (detail::is_hashable<T>::value)
+        {
+          same &= detail::permutation_hashed(values, *other) == permutation;
+        }
+        same &= detail::permutation_sorted(values, *other) == permutation && detail::is_permutation(values, *other) == permutation;
+      }
+    }
+  }
+  return same;
+}
+
+TUNIT_TEST("Set Algorithms", "Strategies Agree")
+{
+  std::mt19937 rng(11);
+  test.expect("int", strategies_agree<int>(rng));
+  test.expect("std::string", strategies_agree<std::string>(rng));
+  test.expect("ordered, not hashable", strategies_agree<Ranked>(rng));
+  test.expect("ordered by a key only", strategies_agree<Keyed>(rng));
+}
+
+TUNIT_TEST("Set Algorithms", "Element Traits")
+{
+  static_assert(detail::is_hashable<std::string>::value && detail::is_ordered<std::string>::value);
+  static_assert(!detail::is_hashable<Ranked>::value && detail::is_ordered<Ranked>::value);
+  static_assert(!detail::is_hashable<Opaque>::value && !detail::is_ordered<Opaque>::value);
+  static_assert(detail::has_consistent_order_v<int> && detail::has_consistent_order_v<std::string> && !detail::has_consistent_order_v<Ranked>);
+  static_assert(detail::has_stable_elements_v<std::list<int>> && !detail::has_stable_elements_v<std::vector<bool>>);
+
+  std::vector<Opaque> opaque;
+  for (int i = 0; i < 200; ++i)
+  {
+    opaque.push_back({i});
+  }
+  test.expect("equality-only elements are unique", pred::is_unique{}(opaque));
+  opaque.push_back({7});
+  test.expect("equality-only elements have a duplicate", !pred::is_unique{}(opaque));
+
+  std::vector<Keyed> keyed;
+  std::vector<Keyed> other_payloads;
+  for (int i = 0; i < 200; ++i)
+  {
+    keyed.push_back({i % 2, i});
+    other_payloads.push_back({i % 2, i + 1000});
+  }
+  test.expect("an order by key does not make elements equal", pred::is_unique{}(keyed));
+  test.expect("equal keys are not a match", !pred::contains_any_elements{}(keyed, other_payloads));
+  test.expect("equal keys are not a permutation", !pred::is_permutation_of{}(keyed, other_payloads));
+  std::vector<Keyed> shuffled_keyed(keyed.rbegin(), keyed.rend());
+  test.expect("same elements in another order are a permutation", pred::is_permutation_of{}(keyed, shuffled_keyed) && pred::contains_all_elements{}(keyed, shuffled_keyed));
+  keyed.push_back({1, 7});
+  test.expect("a duplicate among equivalent elements is found", !pred::is_unique{}(keyed));
+
+  std::vector<bool> flags(100, true);
+  test.expect("vector<bool> contains_any_elements", pred::contains_any_elements{}(flags, std::vector<bool>(100, true)));
+
+  std::list<std::string> words;
+  std::vector<std::string> reversed;
+  for (int i = 0; i < 200; ++i)
+  {
+    words.push_back(make<std::string>(i));
+    reversed.insert(reversed.begin(), make<std::string>(i));
+  }
+  test.expect("list and vector of strings", pred::is_permutation_of{}(words, reversed) && pred::contains_all_elements{}(words, reversed));
+  test.expect("sizes differ", !pred::is_permutation_of{}(words, std::vector<std::string>(reversed.begin() + 1, reversed.end())));
+  test.expect("mixed element types", pred::contains_all_elements{}(std::vector<long>{1, 2, 3}, std::vector<int>{3, 1}));
+}
+
+TUNIT_TEST("Set Algorithms", "Sorted Input Is Not Copied")
+{
+  std::vector<std::string> sorted;
+  for (int i = 0; i < 1000; ++i)
+  {
+    sorted.push_back(make<std::string>(i));
+  }
+  std::sort(sorted.begin(), sorted.end());
+  std::vector<std::string> needles(sorted.begin() + 100, sorted.begin() + 300);
+
+  bool passed = pred::is_unique{}(sorted) && pred::contains_all_elements{}(sorted, needles) && pred::is_permutation_of{}(sorted, sorted);
+  test.expect_no_allocations("is_unique, contains_all_elements and is_permutation_of", [&]()
+                             { passed &= pred::is_unique{}(sorted) && pred::contains_all_elements{}(sorted, needles) &&
+                                         pred::contains_any_elements{}(sorted, needles) && pred::is_permutation_of{}(sorted, sorted); });
+  test.expect("sorted input results", passed);
+}
+
+} // namespace
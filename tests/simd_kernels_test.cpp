@@ -0,0 +1,136 @@
+#include "tUnit.h"
+#include "utils/simd_kernels.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+namespace pred = tUnit::predicates;
+namespace simd = tUnit::utils::simd;
+
+// Lengths around the kernels' 64-element blocks
+constexpr std::size_t sizes[] = {0, 1, 2, 7, 63, 64, 65, 130, 1000};
+
+template <typename T>
+std::vector<T> random_values(std::mt19937 &rng, std::size_t n)
+{
+  std::vector<T> values(n);
+  for (auto &value : values)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      value = static_cast<T>(std::uniform_int_distribution<int>(-8, 8)(rng)) / 2;
+    }
+    else
+    {
+      value = static_cast<T>(std::uniform_int_distribution<int>(-8, 8)(rng));
+    }
+  }
+  return values;
+}
+
+// Every level the CPU supports against the std algorithm, on the same inputs
+template <typename T>
+bool matches_std(std::mt19937 &rng)
+{
+  bool same = true;
+  for (int level = 0; level <= static_cast<int>(simd::best_level()); ++level)
+  {
+    const auto isa = static_cast<simd::Level>(level);
+    for (std::size_t n : sizes)
+    {
+      std::vector<T> values = random_values<T>(rng, n);
+      for (T needle : {T(0), T(3), T(100)})
+      {
+        same &= simd::find(values.data(), n, needle, isa) == static_cast<std::size_t>(std::find(values.begin(), values.end(), needle) - values.begin());
+      }
+
+      std::vector<T> sorted = values;
+      std::sort(sorted.begin(), sorted.end());
+      std::vector<T> reversed(sorted.rbegin(), sorted.rend());
+      for (const auto *range : {&values, &sorted, &reversed})
+      {
+        same &= simd::is_sorted(range->data(), n, false, isa) == std::is_sorted(range->begin(), range->end());
+        same &= simd::is_sorted(range->data(), n, true, isa) == std::is_sorted(range->begin(), range->end(), std::greater<>{});
+      }
+
+      std::vector<T> copy = values;
+      same &= simd::equal(values.data(), copy.data(), n, isa);
+      if (n > 0)
+      {
+        copy[n / 2] = T(100);
+        same &= simd::equal(values.data(), copy.data(), n, isa) == std::equal(values.begin(), values.end(), copy.begin());
+      }
+
+      auto check = [&](simd::ElementTest test, auto predicate)
+      {
+        same &= simd::count(values.data(), n, test, isa) == static_cast<std::size_t>(std::count_if(values.begin(), values.end(), predicate));
+        same &= simd::find_test(values.data(), n, test, true, isa) == static_cast<std::size_t>(std::find_if(values.begin(), values.end(), predicate) - values.begin());
+        same &= simd::find_test(values.data(), n, test, false, isa) == static_cast<std::size_t>(std::find_if_not(values.begin(), values.end(), predicate) - values.begin());
+      };
+      check(simd::ElementTest::positive, pred::is_positive{});
+      check(simd::ElementTest::negative, pred::is_negative{});
+      check(simd::ElementTest::zero, pred::is_zero{});
+      if constexpr (std::is_integral_v<T>)
+      {
+        check(simd::ElementTest::even, pred::is_even{});
+        check(simd::ElementTest::odd, pred::is_odd{});
+      }
+    }
+  }
+  return same;
+}
+
+TUNIT_TEST("SIMD Kernels", "Identical To Std Algorithms")
+{
+  std::mt19937 rng(42);
+  test.expect("signed char", matches_std<signed char>(rng));
+  test.expect("unsigned short", matches_std<unsigned short>(rng));
+  test.expect("int", matches_std<int>(rng));
+  test.expect("unsigned int", matches_std<unsigned int>(rng));
+  test.expect("long long", matches_std<long long>(rng));
+  test.expect("float", matches_std<float>(rng));
+  test.expect("double", matches_std<double>(rng));
+}
+
+TUNIT_TEST("SIMD Kernels", "NaN And Signed Zero")
+{
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> values = {1.0, -0.0, nan, 2.0};
+  std::vector<double> same_values = {1.0, 0.0, nan, 2.0};
+
+  test.expect("NaN is never found", pred::contains_element{}(values, nan), false);
+  test.expect("-0.0 is found as 0.0", pred::contains_element{}(values, 0.0), true);
+  test.expect("NaN never compares equal", pred::containers_equal{}(values, same_values), std::equal(values.begin(), values.end(), same_values.begin()));
+  test.expect("is_sorted treats NaN like std::is_sorted", pred::is_sorted{}(values), std::is_sorted(values.begin(), values.end()));
+  test.expect("-0.0 is neither positive nor negative", pred::count_elements_satisfying{}(values, pred::is_positive{}) == 2 &&
+                                                           pred::no_elements_satisfy{}(std::array<double, 2>{-0.0, 0.0}, pred::is_negative{}));
+}
+
+TUNIT_TEST("SIMD Kernels", "Container Predicates Use Kernels")
+{
+  static_assert(simd::has_kernels_v<std::vector<int>> && simd::has_kernels_v<std::array<float, 4>> && simd::has_kernels_v<std::string>);
+  static_assert(!simd::has_kernels_v<std::vector<bool>> && !simd::has_kernels_v<std::vector<std::string>>);
+
+  std::vector<int> values(10000);
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<int>(i) * 2;
+  }
+  test.expect("contains_element", pred::contains_element{}(values, 19998) && !pred::contains_element{}(values, 19999));
+  test.expect("is_sorted", pred::is_sorted{}(values) && !pred::is_reverse_sorted{}(values));
+  test.expect("all_elements_satisfy is_even", pred::all_elements_satisfy{}(values, pred::is_even{}));
+  test.expect("any_element_satisfies is_zero", pred::any_element_satisfies{}(values, pred::is_zero{}));
+  test.expect("count_elements_satisfying is_positive", pred::count_elements_satisfying{}(values, pred::is_positive{}) == 9999);
+  std::vector<int> copy = values;
+  copy.back() = -1;
+  test.expect("containers_equal", pred::containers_equal{}(values, values) && !pred::containers_equal{}(values, copy));
+}
+
+} // namespace
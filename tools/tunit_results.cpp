@@ -0,0 +1,75 @@
+/**
+ * tunit-results: merges result files from sharded or multi-process runs and converts them
+ *
+ *   tunit-results [--junit <file>] [--json <file>] [--tap <file>] [--binary <file>] [-q] <results>...
+ *
+ * Inputs may be binary (--results) or JUnit XML (-C) files. The console summary is printed
+ * unless -q is given; the exit status is 0 only if every merged test passed, 1 if a test
+ * failed and 3 if an input was missing, corrupt or truncated.
+ */
+#include "tUnit.h"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+  auto &orchestrator = tUnit::Orchestrator::instance();
+  std::vector<std::string> inputs;
+  bool quiet = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const bool has_value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--junit") == 0 && has_value)
+    {
+      orchestrator.add_listener(std::make_unique<tUnit::JUnitReporter>(argv[++i]));
+    }
+    else if (std::strcmp(argv[i], "--json") == 0 && has_value)
+    {
+      orchestrator.add_listener(std::make_unique<tUnit::JsonLinesReporter>(argv[++i]));
+    }
+    else if (std::strcmp(argv[i], "--tap") == 0 && has_value)
+    {
+      orchestrator.add_listener(std::make_unique<tUnit::TapReporter>(argv[++i]));
+    }
+    else if (std::strcmp(argv[i], "--binary") == 0 && has_value)
+    {
+      orchestrator.add_listener(std::make_unique<tUnit::BinaryReporter>(argv[++i]));
+    }
+    else if (std::strcmp(argv[i], "-q") == 0)
+    {
+      quiet = true;
+    }
+    else if (argv[i][0] == '-')
+    {
+      std::cerr << "Usage: " << argv[0] << " [--junit <file>] [--json <file>] [--tap <file>] [--binary <file>] [-q] <results>..." << std::endl;
+      return 2;
+    }
+    else
+    {
+      inputs.emplace_back(argv[i]);
+    }
+  }
+
+  if (inputs.empty())
+  {
+    std::cerr << "tunit-results: no input files" << std::endl;
+    return 2;
+  }
+
+  const bool complete = orchestrator.merge(inputs);
+  if (!quiet)
+  {
+    orchestrator.print_summary();
+  }
+  if (!complete)
+  {
+    // Lost results must never turn into a green build; the failing files were named on stderr
+    std::cerr << "tunit-results: some results could not be read" << std::endl;
+    return 3;
+  }
+  return orchestrator.all_tests_passed() ? 0 : 1;
+}